@@ -3,16 +3,33 @@
 #include "raymath.h"
 
 #include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <climits>
+#include <chrono>
 #include <cmath>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
 #include <ctime>
+#include <deque>
+#include <filesystem>
 #include <functional>
 #include <fstream>
 #include <iostream>
+#include <list>
 #include <memory>
+#include <mutex>
 #include <queue>
 #include <vector>
 #include <string>
+#include <unordered_map>
 #include <sstream>
+#include <thread>
+#include <type_traits>
+#include <variant>
 
 enum class Scene {
     TITLE = 0,
@@ -1,37 +1,118 @@
 #pragma once
 #include "../INIT.hpp"
 #include "../includes/UI.hpp"
+#include "../includes/Tween.hpp"
 
 enum class Direction {
     Forward,
     Backward
 };
 
+class AnimationSchedule;
+
 class Animation {
 private:
     std::function<void(float)> mForward;
     std::function<void(float)> mBackward; // optional, can be nullptr
+    TweenPool* mTweens;                   // optional, tracks evaluated instead of callbacks
+    uint32_t mFirstTrack;
+    uint32_t mTrackCount;
+    std::shared_ptr<AnimationSchedule> mSchedule; // optional, flattened group played as one step, cloned on copy
     float mDuration;                      // seconds
     float mElapsed;                       // seconds
     Direction mDirection;
 
+    void apply();
+
 public:
     // Only forward function
     Animation(const std::function<void(float)>& forward, float duration);
     // Both forward and backward functions
     Animation(const std::function<void(float)>& forward, const std::function<void(float)>& backward, float duration);
+    // Tracks [firstTrack, firstTrack + trackCount) of a pool, played in reverse when backward
+    Animation(TweenPool& tweens, uint32_t firstTrack, uint32_t trackCount, float duration);
+    // Every entry of a schedule, see AnimationGroup
+    explicit Animation(const std::shared_ptr<AnimationSchedule>& schedule);
+    // Copies play independently, a schedule's progress isn't shared
+    Animation(const Animation& other);
+    Animation(Animation&& other)            = default;
+    Animation& operator=(const Animation& other);
+    Animation& operator=(Animation&& other) = default;
 
     void update(float dt);
+    void seek(float elapsed); // Jumps to elapsed seconds and applies that state
     bool isFinished() const;
     void reset();
     void setDirection(Direction dir);
     float getDuration() const;
 };
 
+// Flat table of animations with absolute start times, sorted by start.
+// Evaluating it runs every entry active at that time in one pass. Played
+// backward, entries run their backward animation from their end to their start.
+class AnimationSchedule {
+public:
+    struct Entry {
+        float start;
+        float duration;
+        bool done; // Already applied at its end
+        Animation animation;
+    };
+
+public:
+    AnimationSchedule();
+
+    void add(float start, const Animation& animation);
+    void sort();
+    float getDuration() const;
+    size_t size() const;
+    void evaluate(float time, Direction direction = Direction::Forward);
+
+private:
+    static void seekEntry(Entry& entry, float local, Direction direction);
+
+private:
+    std::vector<Entry> mEntries;
+    float mDuration;
+    float mLastTime;
+};
+
+// Build-time tree of sequences and parallel groups, flattened into a schedule
+class AnimationGroup {
+public:
+    enum Kind {
+        Single,
+        Sequence,
+        Parallel,
+    };
+
+public:
+    AnimationGroup(const Animation& animation);
+    static AnimationGroup sequence(const std::vector<AnimationGroup>& children);
+    static AnimationGroup parallel(const std::vector<AnimationGroup>& children);
+
+    Kind getKind() const;
+    float getDuration() const;
+    // One AnimationList step playing the whole tree
+    Animation build() const;
+
+private:
+    AnimationGroup(Kind kind, const std::vector<AnimationGroup>& children);
+    void flatten(float start, AnimationSchedule& schedule) const;
+
+private:
+    Kind mKind;
+    std::shared_ptr<Animation> mAnimation; // Single only
+    std::vector<AnimationGroup> mChildren;
+    float mDuration;
+};
+
 class AnimationList {
 private:
     void proceedToNext();
     void proceedToPrevious();
+    void rebuildTimeline();
+    void saveCheckpoint(unsigned int animation);
 
     unsigned int mCurrentAnimation;
     float mCooldown;   // Delay between animations in seconds
@@ -40,8 +121,20 @@ private:
     bool mIsPlaying;   // Playback state
     bool mLooping;     // Loop the sequence
     bool mWaiting;     // Waiting between animations
+    bool mInstant;     // Jump to final states instead of playing
     std::vector<Animation> mList;
 
+    // Timeline: start of each animation, cooldowns included, for binary search
+    std::vector<float> mStartTimes;
+    float mTotalDuration;
+    float mTime;
+
+    // Checkpoints: state before every mCheckpointInterval-th animation, stored by the owner
+    unsigned int mCheckpointInterval;
+    std::function<void(unsigned int)> mSaveCheckpoint;
+    std::function<void(unsigned int)> mRestoreCheckpoint;
+    std::vector<bool> mCheckpointSaved;
+
 public:
     AnimationList();
 
@@ -52,8 +145,13 @@ public:
     bool isEmpty() const;
     bool isPlaying() const;
     bool isLooping() const;
+    bool isInstant() const;
+    float getTime() const;
+    float getTotalDuration() const;
+    unsigned int findAnimation(float time) const; // Animation playing at time, O(log n)
 
     void push(const Animation& animation);
+    void push(const AnimationGroup& group);
     void clear();
     void play();
     void pause();
@@ -64,5 +162,15 @@ public:
     void setSpeed(float speed);
     void setLooping(bool looping);
     void setCooldown(float cooldown);
+    void setInstant(bool instant);
+    // Applies the final state of the current and remaining animations, no in-between frames
+    void finish();
+    // save(i) / restore(i) keep and bring back the state before animation i * interval
+    void setCheckpoints(unsigned int interval, const std::function<void(unsigned int)>& save,
+                        const std::function<void(unsigned int)>& restore);
+    // Restores the nearest checkpoint and replays only the animations up to time.
+    // Forward seeks replay from the current animation when that is closer. Going
+    // back without checkpoints, animations are expected to set absolute state.
+    void seek(float time);
     void update(float dt);
 };
\ No newline at end of file
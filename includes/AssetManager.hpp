@@ -0,0 +1,92 @@
+#pragma once
+#include "../INIT.hpp"
+
+// Textures interned by path. Every acquire() needs a matching release(); a
+// texture nobody holds stays loaded ("warm") until WARM_CAPACITY newer ones
+// were released after it, so switching back and forth between scenes doesn't
+// decode images again.
+//
+// preload() decodes images on worker threads, highest priority first. Only
+// the GPU upload runs on the main thread, in update() under a time budget.
+class AssetManager {
+public:
+    static constexpr int WARM_CAPACITY    = 8;
+    static constexpr int DECODE_WORKERS   = 2;
+    static constexpr double UPLOAD_BUDGET = 0.004; // Seconds of uploads per frame
+    static constexpr int PRIORITY_LOW     = 0;
+    static constexpr int PRIORITY_HIGH    = 10;
+
+public:
+    AssetManager();
+    ~AssetManager();
+    AssetManager(const AssetManager&)            = delete;
+    AssetManager& operator=(const AssetManager&) = delete;
+
+    // Starts decoding in the background, needs no window yet
+    void preload(const std::string& path, int priority = PRIORITY_LOW);
+    // Uploads decoded images until budget seconds are spent, main thread only
+    void update(double budget = UPLOAD_BUDGET);
+
+    // A texture with id 0 when loading failed; failures aren't cached, the
+    // next call loads again. Waits for the image if it is still being decoded.
+    Texture2D acquire(const std::string& path);
+    // Never waits: true with a reference once the texture is ready, or once with
+    // an id 0 texture if decoding failed, after which a failed decode is
+    // forgotten. Otherwise starts decoding and returns false.
+    bool tryAcquire(const std::string& path, Texture2D& texture);
+    void release(Texture2D texture); // Unknown or empty textures are ignored
+    void clear();                    // Unloads everything, needs the GL context
+
+    // Statistics
+    int getLoadedCount() const;
+    int getWarmCount() const; // Loaded but not referenced
+    int getPendingCount();    // Queued or decoded, not uploaded yet
+    int getLoads() const;
+    int getHits() const;
+
+private:
+    struct Entry {
+        Texture2D texture;
+        int references;
+        uint64_t releasedAt; // Clock at the last release, for eviction
+    };
+
+    struct Decode {
+        enum State : uint8_t { QUEUED, DECODING, DECODED, FAILED };
+        State state;
+        int priority;
+        Image image;
+        double milliseconds;
+    };
+
+    struct Job {
+        int priority;
+        uint64_t order;
+        std::string path;
+        bool operator<(const Job& other) const; // Higher priority, then earlier
+    };
+
+    bool reference(const std::string& path, Texture2D& texture);
+    void enqueue(const std::string& path, int priority); // mMutex held
+    Texture2D upload(const std::string& path, Image image, double decodeMilliseconds, int references);
+    void decodeLoop();
+    void evict();
+
+private:
+    std::unordered_map<std::string, Entry> mEntries;
+    std::unordered_map<unsigned int, std::string> mPaths; // Texture id to path
+    uint64_t mClock;
+    int mWarm;
+    int mLoads;
+    int mHits;
+
+    // Shared with the decode workers
+    std::mutex mMutex;
+    std::condition_variable mHasJob;
+    std::condition_variable mDecoded;
+    std::priority_queue<Job> mJobs;
+    std::unordered_map<std::string, Decode> mDecodes;
+    std::vector<std::thread> mWorkers;
+    uint64_t mJobOrder;
+    bool mStopping;
+};
\ No newline at end of file
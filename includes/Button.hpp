@@ -14,6 +14,7 @@ protected:
 
     const char* text;
     int fontSize;
+    int textWidth; // Measured on first draw after the text or font size changes, -1 when stale
     bool isHovered;
 
 public:
@@ -43,7 +44,7 @@ class ChangeSceneButton : public Button {
 private:
     Scene targetScene;
     Texture2D icon;
-    bool ownTexture; // Whether we loaded the texture and should unload it
+    bool ownTexture; // Whether we hold a reference to the texture in the asset manager
     bool isBackButton;
 
 public:
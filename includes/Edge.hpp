@@ -1,5 +1,6 @@
 #pragma once
 #include "../INIT.hpp"
+#include "../includes/TextCache.hpp"
 
 class PolyNode;
 
@@ -19,6 +20,31 @@ enum TargetType {
     Top
 };
 
+// 32-bit edge reference: 24-bit slot index and 8-bit generation.
+// A handle goes stale as soon as its edge is destroyed.
+class EdgeHandle {
+public:
+    static constexpr uint32_t INDEX_BITS      = 24;
+    static constexpr uint32_t INDEX_MASK      = (1u << INDEX_BITS) - 1;
+    static constexpr uint32_t GENERATION_MASK = 0xFFu;
+    static constexpr uint32_t INVALID         = 0xFFFFFFFFu;
+
+public:
+    EdgeHandle() : mValue(INVALID) {}
+    EdgeHandle(uint32_t index, uint32_t generation)
+        : mValue((generation << INDEX_BITS) | (index & INDEX_MASK)) {}
+
+    uint32_t getIndex() const { return mValue & INDEX_MASK; }
+    uint32_t getGeneration() const { return mValue >> INDEX_BITS; }
+    bool isValid() const { return mValue != INVALID; }
+
+    bool operator==(const EdgeHandle& handle) const { return mValue == handle.mValue; }
+    bool operator!=(const EdgeHandle& handle) const { return mValue != handle.mValue; }
+
+private:
+    uint32_t mValue;
+};
+
 class Edge {
 
 public:
@@ -42,22 +68,47 @@ public:
     // Getters
     PolyNode* getTo() const;
     PolyNode* getFrom() const;
+    int getWeight() const;
+    int getType() const;
     Vector2 getDestination() const;
-
-    // Update and draw
-    void update(float dt);
-    void draw();
+    Rectangle getBounds() const; // World-space box of the cached geometry
+    const std::string& getLabel() const;
+
+    // Cached geometry for batched drawing
+    Vector2 getStart() const;
+    Color getDrawColor() const;
+    float getThickness() const;
+    void getArrowHead(Vector2& left, Vector2& right) const;
+    void getLoop(Vector2& center, float& radius) const;
+
+    // Arena bookkeeping: own handle and positions in the endpoints' edge lists
+    void setHandle(EdgeHandle handle);
+    EdgeHandle getHandle() const;
+    void setOutSlot(uint32_t slot);
+    uint32_t getOutSlot() const;
+    void setInSlot(uint32_t slot);
+    uint32_t getInSlot() const;
+
+    // Change tracking, geometry is only recomputed for dirty edges
+    void markDirty();
+    bool isDirty() const;
+
+    // Update returns true when the geometry changed. The geometry itself is
+    // drawn by EdgeRenderer, labels are recorded here.
+    bool update(float dt);
+    void drawLabels(RenderQueue& queue) const;
 
 private:
+    struct EdgeText;
+
     // Drawing helper methods
-    void drawLine(Vector2 start, Vector2 end);
-    void drawArrow(Vector2 start, Vector2 end);
-    void drawCircularArrow(Vector2 start, Vector2 end);
-    void drawWeightLabel();
-    void drawPointerLabel();
+    void drawWeightLabel(RenderQueue& queue) const;
+    void drawPointerLabel(RenderQueue& queue) const;
+    EdgeText& text() const;
 
     // Calculation helpers
     Vector2 calculateTargetPoint(PolyNode* node, TargetType type);
+    void updateGeometry();
 
 private:
     // Core properties
@@ -65,14 +116,26 @@ private:
     int mType;
     int mWeight;
 
+    // Arena bookkeeping
+    EdgeHandle mHandle;
+    uint32_t mOutSlot;
+    uint32_t mInSlot;
+
     // Visual properties
     Color mColor;
     Color mHighlightColor;
     float mThickness;
     bool mHighlighted;
 
+    // Label text, allocated on first use since most edges never show any
+    struct EdgeText {
+        TextLayout weight;
+        TextLayout label;
+        bool weightStale; // mWeight changed since weight was laid out
+    };
+    mutable std::unique_ptr<EdgeText> mText;
+
     // Pointer-specific properties
-    std::string mLabel;
     Vector2 mLabelOffset;
     Vector2 mDestination;
     Vector2 mTargetDestination;
@@ -82,8 +145,17 @@ private:
     // Animation properties
     float mAnimationSpeed;
 
+    // Cached geometry, valid while the edge is clean
+    bool mDirty;
+    Vector2 mStart;
+    Vector2 mMidpoint;
+    Vector2 mArrowLeft;
+    Vector2 mArrowRight;
+
     // Constants
     static constexpr float ARROW_SIZE        = 10.0f;
     static constexpr float CIRCULAR_OFFSET   = -60.0f;
     static constexpr float DEFAULT_THICKNESS = 2.0f;
+    static constexpr float WEIGHT_FONT_SIZE  = 20.0f;
+    static constexpr float LABEL_FONT_SIZE   = 18.0f;
 };
\ No newline at end of file
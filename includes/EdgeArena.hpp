@@ -0,0 +1,49 @@
+#pragma once
+#include "../INIT.hpp"
+#include "../includes/Edge.hpp"
+
+// Contiguous edge storage owned by a graph.
+// Edges are packed densely for iteration, handles go through a slot table so
+// destroying an edge is a swap-and-pop. Edge pointers are only valid until the
+// next create() or destroy(), keep handles instead. Handles must not be kept
+// across clear(), which starts the slot table over.
+class EdgeArena {
+public:
+    EdgeArena() = default;
+    EdgeArena(const EdgeArena&)            = delete;
+    EdgeArena& operator=(const EdgeArena&) = delete;
+
+    // An invalid handle once every slot index is taken
+    EdgeHandle create(PolyNode* from, PolyNode* to, int type = EdgeType::Directed);
+    void destroy(EdgeHandle handle);
+    void clear();
+    void reserve(size_t edges);
+
+    // Returns nullptr for stale handles
+    Edge* get(EdgeHandle handle);
+    Edge* getBySlot(uint32_t slot); // Live edge in a slot, the slot is the handle's index
+    const Edge* get(EdgeHandle handle) const;
+    bool contains(EdgeHandle handle) const;
+
+    int size() const;
+    bool empty() const;
+
+    // Dense iteration over all live edges
+    std::vector<Edge>::iterator begin() { return mEdges.begin(); }
+    std::vector<Edge>::iterator end() { return mEdges.end(); }
+    std::vector<Edge>::const_iterator begin() const { return mEdges.begin(); }
+    std::vector<Edge>::const_iterator end() const { return mEdges.end(); }
+
+private:
+    struct Slot {
+        uint32_t dense;      // Position in mEdges, or next free slot when unused
+        uint32_t generation; // Bumped on every destroy, GENERATION_MASK once retired
+    };
+
+    void release(uint32_t slot);
+
+    std::vector<Edge> mEdges;
+    std::vector<uint32_t> mDenseToSlot;
+    std::vector<Slot> mSlots;
+    uint32_t mFreeSlot = EdgeHandle::INVALID;
+};
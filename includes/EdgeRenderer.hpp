@@ -0,0 +1,45 @@
+#pragma once
+#include "../INIT.hpp"
+#include "../includes/Edge.hpp"
+
+// Draws many edges at once. Edges are bucketed by their EdgeType bits, each bucket is
+// expanded by a kernel specialized for that combination into one vertex stream, and
+// the stream is recorded into the render queue as a single triangle run.
+class EdgeRenderer {
+public:
+    static constexpr int LOOP_SEGMENTS = 20;
+
+public:
+    EdgeRenderer();
+
+    void begin();
+    void add(const Edge& edge);
+    void flush(RenderQueue& queue); // Records geometry, then labels after it
+
+    // Statistics of the last flush
+    int getEdgeCount() const;
+    int getLabelCount() const; // Each a background box and a glyph run
+    int getVertexCount() const;
+    int getImmediateShapeCalls() const; // raylib Draw* calls, text included, drawing each edge on its own makes
+
+private:
+    static constexpr int BUCKETS = (EdgeType::Directed | EdgeType::Weighted | EdgeType::Circular) + 1;
+
+    template <int Type>
+    void writeBucket(const std::vector<const Edge*>& edges);
+
+    void writeLine(Vector2 start, Vector2 end, float thickness, Color color);
+    void writeTriangle(Vector2 a, Vector2 b, Vector2 c, Color color);
+    void writeLoop(const Edge& edge, Color color);
+    void submit(RenderQueue& queue);
+
+private:
+    std::vector<const Edge*> mBuckets[BUCKETS];
+    std::vector<const Edge*> mLabelled;
+    std::vector<RenderVertex> mVertices;
+
+    int mEdgeCount;
+    int mLabelCount;
+    int mVertexCount;
+    int mImmediateShapeCalls;
+};
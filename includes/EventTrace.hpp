@@ -0,0 +1,112 @@
+#pragma once
+#include "../INIT.hpp"
+#include "../includes/Node.hpp"
+#include "../includes/Animation.hpp"
+
+// Packed stream of algorithm events: an opcode byte followed by varint operands,
+// so a typical event takes 3 to 5 bytes. Step events split the stream into the
+// frames a player shows one at a time.
+class EventTrace {
+public:
+    enum Opcode : uint8_t {
+        Step,            // End of one visual step
+        HighlightNode,   // node, highlight
+        HighlightEdge,   // from, to, on
+        SetLabel,        // node, string
+        SetData,         // node, zigzag value
+        SwapData,        // node, node
+        SetEdgeWeight,   // from, to, zigzag weight
+        ClearHighlights, // -
+        OpcodeCount,
+    };
+
+    static constexpr uint32_t MAGIC   = 0x43525441; // "ATRC"
+    static constexpr uint32_t VERSION = 1;
+
+    // A decoded event, args in the order listed above
+    struct Event {
+        Opcode op;
+        int64_t args[3];
+    };
+
+public:
+    EventTrace();
+
+    // Recording
+    void highlightNode(int node, PolyNode::Highlight type);
+    void highlightEdge(int from, int to, bool on = true);
+    void setLabel(int node, const std::string& label);
+    void setData(int node, int64_t value);
+    void swapData(int a, int b);
+    void setEdgeWeight(int from, int to, int weight);
+    void clearHighlights();
+    void step();
+
+    void clear();
+    void reserve(size_t bytes);
+
+    // Stream access
+    const std::vector<uint8_t>& getBytes() const;
+    const std::string& getString(uint32_t id) const; // Empty for unknown ids
+    size_t getStepCount() const;
+    size_t getByteSize() const; // Stream plus string table
+
+    // Decodes the event at offset and moves offset past it. False if the event
+    // is cut off or has an operand out of range (a node id past INT_MAX, an
+    // unknown string id, ...)
+    bool readEvent(size_t& offset, Event& event) const;
+    // Reads a varint at offset and moves offset past it, false if it is cut off
+    static bool readVarint(const std::vector<uint8_t>& bytes, size_t& offset, uint64_t& value);
+    static int64_t unzigzag(uint64_t value);
+
+    // Rejects files whose counts don't fit their size or whose events don't decode
+    bool load(const std::string& path);
+    bool save(const std::string& path) const;
+
+private:
+    void writeOpcode(Opcode op);
+    void writeVarint(uint64_t value);
+    void writeSigned(int64_t value);
+    uint32_t intern(const std::string& text);
+    bool validate() const;
+
+private:
+    std::vector<uint8_t> mBytes;
+    std::vector<std::string> mStrings; // Labels, referenced by index
+    std::unordered_map<std::string, uint32_t> mStringIds;
+    size_t mSteps;
+};
+
+// Interprets an EventTrace against the nodes of a scene. The trace has to
+// outlive the player and the animations made from it.
+class TracePlayer {
+public:
+    // nodes(id) resolves ids to nodes and returns nullptr past the last one
+    TracePlayer(const EventTrace& trace, const std::function<PolyNode*(int)>& nodes);
+
+    // Runs the events of the next step, false once the trace is done or broken
+    bool stepForward();
+    // Runs steps until step is reached, only forwards: reset() the scene to go back
+    void advanceTo(size_t step);
+    void reset();
+
+    size_t getStep() const;
+    bool isFinished() const;
+    bool hasFailed() const; // Stopped at an event that didn't decode
+
+    // One animation playing the whole trace, stepDuration seconds per step, on
+    // a copy of this player. restore() puts the scene back in the state the
+    // trace starts from, so seeking backward replays from there; without it the
+    // animation only moves forward.
+    Animation toAnimation(float stepDuration, const std::function<void()>& restore = nullptr) const;
+
+private:
+    void execute(const EventTrace::Event& event);
+
+private:
+    const EventTrace* mTrace;
+    std::function<PolyNode*(int)> mNodes;
+    size_t mOffset;
+    size_t mStep;
+    bool mFailed;
+};
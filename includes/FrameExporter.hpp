@@ -0,0 +1,61 @@
+#pragma once
+#include "../INIT.hpp"
+
+// Command-line export settings: --export <scene> <frames> <directory> [--format png|qoi] [--fps N] [--workers N]
+// or --count <scene> <frames> [--fps N] to only count draw commands, nothing is written
+struct ExportOptions {
+    Scene scene        = Scene::GRAPH;
+    int frames         = 0;
+    std::string directory;
+    std::string format = "png";
+    float fps          = 60.0f;
+    int workers        = 0;     // 0: one per hardware thread
+    bool count         = false; // Frames go to a NullBackend instead of image files
+};
+
+// Writes frames to numbered image files on a pool of worker threads.
+// The main thread only reads frames back, flipping and encoding happen on the workers.
+class FrameExporter {
+public:
+    static constexpr const char* EXPORT_ARGUMENT = "--export";
+    static constexpr const char* COUNT_ARGUMENT  = "--count";
+    static constexpr int PENDING_PER_WORKER     = 2; // Frames queued per worker before submit() waits
+
+public:
+    FrameExporter(const std::string& directory, const std::string& format, int workers = 0);
+    ~FrameExporter();
+
+    static bool parseArguments(int argc, char* argv[], ExportOptions& options);
+
+    // Takes ownership of image, which is still upside down as read from a render texture
+    void submit(Image image, int frame);
+    // Waits for every submitted frame, false if any failed to write
+    bool finish();
+
+    int getWorkerCount() const;
+    int getWrittenCount() const;
+
+private:
+    struct Job {
+        Image image;
+        int frame;
+    };
+
+    void work();
+    std::string framePath(int frame) const;
+
+private:
+    std::string mDirectory;
+    std::string mFormat;
+    std::vector<std::thread> mWorkers;
+
+    std::mutex mMutex;
+    std::condition_variable mHasJob;
+    std::condition_variable mHasRoom;
+    std::queue<Job> mJobs;
+    size_t mMaxPending;
+    bool mStopping;
+
+    std::atomic<int> mWritten;
+    std::atomic<bool> mFailed;
+};
@@ -3,7 +3,13 @@
 #include "../includes/Button.hpp"
 #include "../includes/UI.hpp"
 #include "../includes/Animation.hpp"
+#include "../includes/EventTrace.hpp"
 #include "../includes/GraphNode.hpp"
+#include "../includes/LayoutCache.hpp"
+#include "../includes/SpatialGrid.hpp"
+#include "../includes/EdgeRenderer.hpp"
+#include "../includes/NodeRenderer.hpp"
+#include "../includes/Random.hpp"
 
 class Graph : public SceneManager {
 public:
@@ -16,6 +22,14 @@ public:
     static constexpr int UPDATE_LOOPS    = 100;
     static constexpr float FORCE_EPSILON = 0.01f;
     static constexpr float COOL_DOWN     = 0.95f;
+    static constexpr float WARM_COOL_DOWN = 0.5f; // Starting cooldown when resuming a cached layout
+
+    // Spatial index
+    static constexpr float GRID_CELL_SIZE = 100.0f;
+    static constexpr float CULL_MARGIN    = 40.0f; // Room for labels outside node and edge boxes
+
+    // Algorithm playback
+    static constexpr float TRACE_STEP = 0.6f; // Seconds per recorded step
 
     // Edge representation
     struct EdgeTuple {
@@ -41,6 +55,9 @@ public:
     void update() override;
     void draw() override;
     void clean() override;
+    void fixedUpdate(float dt) override;
+    void loadDemo() override;
+    bool isAnimating() const override;
 
     // Graph management
     void clear();
@@ -48,21 +65,33 @@ public:
     void loadFromFile(const std::string& fileDir);
     void randomize(int nodes, int edges);
     void build(int nodes);
+    void removeNode(int id);
     void addEdge(int from, int to, int weight = 1);
     void removeEdge(int from, int to);
 
-    // Graph properties
+    // Graph properties, both are view flags over the same edges
     void setDirected(bool isDirected);
     void setWeighted(bool isWeighted);
 
-    // Algorithms with animation
+    // Algorithms with animation, recorded as traces and played back step by step
+    void recordBFS(int start, EventTrace& trace) const; // Visit order as labels
+    void playBFS(int start);
     //std::vector<Animation> CCAnimation();  // Connected Components
     //std::vector<Animation> MSTAnimation(); // Minimum Spanning Tree
     //std::vector<Animation> DijkstraAnimation(int start);
 
     // Getters
     int getNumNodes() const;
+    PolyNode* getNode(int id); // nullptr if there is no such node, e.g. for a TracePlayer
     int getNumEdges() const;
+    std::vector<EdgeTuple> getEdges() const;
+
+    // Picking, returns the node under a world position or -1
+    int pickNode(Vector2 position) const;
+
+    // Culling statistics of the last frame
+    int getDrawnNodes() const;
+    int getDrawnEdges() const;
 
     private:
     // Helper methods
@@ -70,6 +99,22 @@ public:
     //void DFS(const GraphNode* node, std::vector<int>& components);
     void arrangeNodes();
 
+    // Topology helpers
+    static uint64_t edgeKey(int from, int to);
+    static int nodeId(const PolyNode* node);
+    EdgeHandle findEdge(int from, int to) const;
+    void removeEdge(EdgeHandle handle);
+    void applyEdgeTypes();
+
+    // Interaction helpers
+    void updateNodeGrid(int id);
+    void handleNodeDragging();
+
+    // Layout cache helpers
+    LayoutCache::EdgeList layoutEdges() const;
+    bool restoreLayout();
+    void saveLayout();
+
 private:
     float mMaxForce;
     float mCoolDown;
@@ -78,8 +123,31 @@ private:
     bool mIsDirected;
     bool mIsWeighted;
 
+    RandomStream mRandom; // Graph's stream of the run seed
+
+    std::string mLayoutPath;     // Sidecar of the loaded graph file, empty if none
+    uint64_t mLayoutFingerprint; // Of the graph as loaded, edited graphs aren't saved
+    bool mLayoutSaved;
+
+    // Topology: the arena is the only edge store, mEdgeIndex maps (from, to) to its edge
+    EdgeArena mEdgeArena; // Must outlive mNodes
     std::vector<std::unique_ptr<GraphNode>> mNodes;
-    std::vector<EdgeTuple> mEdges;
+    std::unordered_map<uint64_t, EdgeHandle> mEdgeIndex;
+
+    // Node positions for picking and culling, keyed by node id
+    SpatialGrid mNodeGrid;
+    // Edge boxes for culling, keyed by the edge's arena slot
+    SpatialGrid mEdgeGrid;
+    std::vector<int> mVisible;
+    EdgeRenderer mEdgeRenderer;
+    NodeRenderer mNodeRenderer;
+    int mDrawnNodes;
+    int mDrawnEdges;
+    int mDragNode;
+    Vector2 mDragOffset;
+
+    EventTrace mTrace; // Of the algorithm in mAnimations
+    AnimationList mAnimations;
 
     Camera2DComponent* camera;
     std::vector<std::unique_ptr<Button>> buttons;
@@ -9,37 +9,51 @@ public:
     static constexpr float ATTRACT      = 0.2f;
     static constexpr float LENGTH_LIMIT = 150.0f;
     static constexpr float MIN_DISTANCE = 80.0f;
+    static constexpr float REST_SPEED   = 0.01f; // Below this speed a node is at rest
+    static constexpr float DAMPING      = 0.95f; // Velocity kept per DAMPING_STEP seconds
+    static constexpr float DAMPING_STEP = 1.0f / 60.0f;
 
     // Boundaries for the graph layout
     static constexpr float MARGIN = 100.0f; // Margin from screen edges
 
 public:
-    explicit GraphNode(Font font);
-    virtual ~GraphNode() = default;
+    GraphNode(Font font, EdgeArena& edges);
+    ~GraphNode() override = default;
+
+    // Index of the node in its graph
+    void setId(int id);
+    int getId() const;
 
     // Physics properties
     void setVelocity(Vector2 velocity);
     Vector2 getVelocity() const;
 
-    // Node connections
-    void makeAdjacent(GraphNode* node);
+    // Simulated position, the drawn one follows it through interpolate().
+    // Setting it, also through a PolyNode pointer, jumps without interpolating.
+    using PolyNode::setPosition;
+    void setPosition(Vector2 position) override;
+    Vector2 getSimulatedPosition() const;
+    bool interpolate(float alpha); // Draw between the last two ticks, true if the drawn position moved
+
+    // Node connections, read from the graph's edges in either direction
     bool isAdjacent(const GraphNode& node) const;
-    const std::vector<GraphNode*>& getAdjacent() const;
 
     // Force calculations for graph layout
     Vector2 getRepulsion(const GraphNode& node) const;
     Vector2 getAttraction(const GraphNode& node) const;
     Vector2 getTotalAttraction() const;
 
-    // Override update to include physics
+    // Override update to include physics, called once per fixed tick
     void update(float dt);
 
     // Set screen boundaries for all nodes
     static void setScreenBoundaries(float left, float right, float top, float bottom);
 
 private:
-    std::vector<GraphNode*> mAdjacent;
+    int mId;
     Vector2 mVelocity;
+    Vector2 mPrevious; // Simulated position at the previous tick
+    Vector2 mCurrent;  // Simulated position at the latest tick
 
     // Static boundaries that will be set from screen size
     static float sLeft;
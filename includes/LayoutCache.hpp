@@ -0,0 +1,42 @@
+#pragma once
+#include "../INIT.hpp"
+
+// Binary sidecar ("<graph file>.layout") holding converged node positions.
+// Layouts are keyed by a fingerprint of the node count and the sorted edge set.
+// The edge set is stored too, so a slightly edited graph can still reuse it.
+class LayoutCache {
+public:
+    using EdgeList = std::vector<std::pair<int, int>>;
+
+    static constexpr uint32_t MAGIC         = 0x4C594F54; // "TOYL"
+    static constexpr uint32_t VERSION       = 2;
+    static constexpr float NEAR_NODES       = 0.1f; // Node count may differ by this fraction
+    static constexpr float NEAR_EDGES       = 0.8f; // Minimum share of common edges
+
+public:
+    LayoutCache();
+
+    // Fingerprint of a graph, edges are (from, to) pairs and must be sorted
+    static uint64_t fingerprint(int nodes, const EdgeList& edges);
+    static std::string sidecarPath(const std::string& graphFile);
+    static int maxNearNodes(int nodes); // Largest node count isNear() accepts
+
+    // Files larger than maxNodes or not matching their header are rejected
+    bool load(const std::string& path, int maxNodes);
+    bool save(const std::string& path) const;
+
+    // Cached data
+    uint64_t getFingerprint() const;
+    int getNumNodes() const;
+    const std::vector<Vector2>& getPositions() const;
+    const EdgeList& getEdges() const;
+    bool matches(uint64_t fingerprint, int nodes) const;
+    bool isNear(int nodes, const EdgeList& edges) const; // Close enough to start from
+
+    void setLayout(uint64_t fingerprint, const std::vector<Vector2>& positions, const EdgeList& edges);
+
+private:
+    uint64_t mFingerprint;
+    std::vector<Vector2> mPositions;
+    EdgeList mEdges;
+};
\ No newline at end of file
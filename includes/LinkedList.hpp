@@ -3,6 +3,7 @@
 #define LINKEDLIST_HPP
 
 #include "UI.hpp"
+#include "Random.hpp"
 #include "raylib.h"
 #include <string>
 
@@ -20,6 +21,9 @@ public:
     void update() override;
     void draw() override;
     void clean() override;
+    void fixedUpdate(float dt) override;
+    void loadDemo() override;
+    bool isAnimating() const override;
     void DrawList(const std::vector<Vector2>& positions, int highlightIndex, Node* head);
     void DrawNode(int value);
     void GetInputFromFile(const std::string& filename);
@@ -34,10 +38,15 @@ public:
 private:
     void StartSearchOperation(int searchValue);
     void StartDeleteOperation(int deleteValue);
+    void CompletePendingInsertion();
+    void StepSearch(float dt);
+    void StepDelete(float dt);
+    void FastForward(double budget);
     void ClearList();
     std::vector<std::unique_ptr<Button>> buttons;
     Camera2DComponent* camera;
     Node* head;
+    RandomStream random;
 };
 
 #endif // LINKEDLIST_HPP
@@ -1,26 +1,34 @@
 #pragma once
 #include "../INIT.hpp"
-#include "../includes/Edge.hpp"
+#include "../includes/EdgeArena.hpp"
+#include "../includes/TextCache.hpp"
+#include "../includes/NodeStyle.hpp"
+#include "../includes/NodeValue.hpp"
 
 class PolyNode {
 public:
-    enum Highlight {
+    enum Highlight : uint8_t {
         None,
         Primary,
         Secondary,
     };
 
 public:
-    explicit PolyNode(Font font);
-    ~PolyNode();
+    PolyNode(Font font, EdgeArena& edges);
+    virtual ~PolyNode();
 
     // Data management
     std::string getData() const;
     int getIntData() const;
+    const NodeValue& getValue() const;
     float getRadius() const;
+    Color getFillColor() const;
+    Color getOutlineColor() const;
 
     void setData(const std::string& data);
-    void setData(int data);
+    template <typename T, std::enable_if_t<std::is_arithmetic_v<T>, int> = 0>
+    void setData(T data) { setValue(NodeValue(data)); }
+    void setValue(const NodeValue& value);
     void swapData(PolyNode* node);
     void setLabel(const std::string& label);
     void setLabel(int label);
@@ -29,52 +37,62 @@ public:
     void setRadius(float radius);
     void resetDataScale();
 
+    // Style management
+    void setStyle(uint16_t style);
+    uint16_t getStyle() const;
+    Highlight getHighlight() const;
+
     // Edge management
     void addEdgeOut(PolyNode* to, int type = Directed);
-    void addEdgeIn(std::shared_ptr<Edge> edge);
+    void addEdgeIn(EdgeHandle edge);
     void removeEdgeOut(PolyNode* to);
-    void removeEdgeIn(std::shared_ptr<Edge> edge);
+    void removeEdgeIn(EdgeHandle edge);
     void removeAllEdges();
     void highlightEdge(PolyNode* to, bool highlight = true);
     void setEdgeWeight(PolyNode* to, int weight);
     void setEdgeType(PolyNode* to, int type);
     void clearEdgeHighlights();
 
-    // Position management
+    // Position management, subclasses may track where the node is headed
     void setPosition(float x, float y);
-    void setPosition(Vector2 position);
+    virtual void setPosition(Vector2 position);
     Vector2 getPosition() const;
 
-    // Update and draw
+    // Update and draw, the circle itself is drawn by NodeRenderer
     void update(float dt);
-    void draw();
+    void drawLabels(RenderQueue& queue);
+    bool isResizing() const; // Scale still animating
+
+    const std::vector<EdgeHandle>& getOutEdges() const { return outEdges; }
+    const std::vector<EdgeHandle>& getInEdges() const { return inEdges; }
+    Edge* getEdgeOut(PolyNode* to);
 
-    const std::vector<std::shared_ptr<Edge>>& getOutEdges() const { return outEdges; }
+protected:
+    const EdgeArena& getEdgeArena() const { return *mEdgeArena; }
 
 private:
     // Helper methods
-    void renderNodeShape();
-    void renderText();
+    void markEdgesDirty();
+    void detachOut(uint32_t slot);
+    void detachIn(uint32_t slot);
 
 private:
-    // Node properties
-    std::string mData;
-    std::string mLabel;
+    // Node properties, the display text of mValue is built when first drawn
+    NodeValue mValue;
+    TextRun mData;
+    bool mDataDirty;
+    TextRun mLabel;
     Vector2 mPosition;
     float mRadius;
 
-    // Visual properties
-    Color mBaseColor;
-    Color mCurrentColor;
-    Color mTextColor;
-    Color mHighlightPrimaryColor;
-    Color mHighlightSecondaryColor;
-    Font mFont;
-    float mFontSize;
+    // Visual properties, fonts and colours live in the shared style table
+    uint16_t mStyle;
+    Highlight mHighlight;
 
-    // Edges
-    std::vector<std::shared_ptr<Edge>> inEdges;
-    std::vector<std::shared_ptr<Edge>> outEdges;
+    // Edges, stored in the owning graph's arena
+    EdgeArena* mEdgeArena;
+    std::vector<EdgeHandle> inEdges;
+    std::vector<EdgeHandle> outEdges;
 
     // Animation properties
     float mScale;
@@ -0,0 +1,46 @@
+#pragma once
+#include "../INIT.hpp"
+#include "../includes/Node.hpp"
+
+// Draws node circles in one batch. Unit-circle meshes are built once per level of
+// detail, nodes only contribute a transform and colours to the instance buffer.
+// The circles are recorded into the render queue as one triangle run for the
+// fills and one line run for the outlines.
+class NodeRenderer {
+public:
+    static constexpr int LOD_LEVELS       = 5;
+    static constexpr float LOD_RADIUS[LOD_LEVELS - 1] = {4.0f, 10.0f, 25.0f, 60.0f}; // On-screen pixels
+    static constexpr int LOD_SEGMENTS[LOD_LEVELS]     = {8, 16, 24, 36, 48};
+
+public:
+    NodeRenderer();
+
+    // pixelsPerUnit is the camera zoom, used to pick the level of detail
+    void begin(float pixelsPerUnit = 1.0f);
+    void add(const PolyNode& node);
+    void flush(RenderQueue& queue);
+
+    // Statistics of the last flush
+    int getNodeCount() const;
+    int getVertexCount() const;
+
+private:
+    struct Instance {
+        float x, y, radius;
+        Color fill;
+        Color outline;
+    };
+
+    static const std::vector<Vector2>& unitCircle(int level);
+    int levelOf(float radius) const;
+    // Write the vertices of one level of detail, return the end of what they wrote
+    RenderVertex* writeFills(int level, const std::vector<Instance>& instances, RenderVertex* out) const;
+    RenderVertex* writeOutlines(int level, const std::vector<Instance>& instances, RenderVertex* out) const;
+
+private:
+    std::vector<Instance> mInstances[LOD_LEVELS];
+    float mPixelsPerUnit;
+
+    int mNodeCount;
+    int mVertexCount;
+};
@@ -0,0 +1,34 @@
+#pragma once
+#include "../INIT.hpp"
+
+// Look of a node, shared by every node that uses it
+struct NodeStyle {
+    Font font;
+    float fontSize;
+    float labelFontSize;
+    float spacing;
+    Color baseColor;
+    Color textColor;
+    Color outlineColor;
+    Color highlightPrimaryColor;
+    Color highlightSecondaryColor;
+
+    bool operator==(const NodeStyle& other) const;
+};
+
+// Interned styles, nodes keep a 16-bit index instead of their own copy
+class NodeStyleTable {
+public:
+    static constexpr uint16_t MAX_STYLES = UINT16_MAX;
+
+public:
+    // Returns the index of an equal style, adding it if it is new
+    static uint16_t intern(const NodeStyle& style);
+    static const NodeStyle& get(uint16_t index);
+    static size_t size();
+
+    static NodeStyle makeDefault(Font font);
+
+private:
+    static std::vector<NodeStyle> sStyles;
+};
@@ -0,0 +1,74 @@
+#pragma once
+#include "../INIT.hpp"
+
+// Interned strings, so a node value only needs a 32-bit id for text.
+// Ids are reference counted; a string nobody holds is dropped and its id reused.
+class StringTable {
+public:
+    static uint32_t intern(const std::string& text); // Adds a reference
+    static void retain(uint32_t id);
+    static void release(uint32_t id);
+    static const std::string& get(uint32_t id);
+    static size_t size(); // Strings currently held
+
+private:
+    struct Slot {
+        std::string text;
+        uint32_t references;
+    };
+
+    static std::unordered_map<std::string, uint32_t> sIds;
+    static std::deque<Slot> sSlots; // Deque keeps references stable
+    static std::vector<uint32_t> sFree;
+};
+
+// Value held by a node: nothing, an integer, a real number or an interned string.
+// Numeric reads of numbers never parse or allocate; strings are read like
+// std::stoi would, by their leading number.
+class NodeValue {
+public:
+    enum Kind : uint8_t {
+        Empty,
+        Integer,
+        Real,
+        String,
+    };
+
+public:
+    NodeValue();
+    NodeValue(double value);
+    // Any integer type, so unsigned and size_t arguments aren't ambiguous
+    template <typename T, std::enable_if_t<std::is_integral_v<T>, int> = 0>
+    NodeValue(T value)
+        : mValue(static_cast<int64_t>(value))
+    {
+    }
+
+    NodeValue(const NodeValue& other);
+    NodeValue(NodeValue&& other) noexcept;
+    NodeValue& operator=(const NodeValue& other);
+    NodeValue& operator=(NodeValue&& other) noexcept;
+    ~NodeValue();
+
+    // Integer text round-trips to an Integer, anything else is interned
+    static NodeValue fromString(const std::string& text);
+
+    Kind getKind() const;
+    bool empty() const;
+    bool isNumber() const;
+
+    int64_t asInt() const;  // Reals truncate, text without a leading number and empty read as 0
+    double asReal() const;  // Same for text, empty reads as 0
+    std::string toString() const;
+
+    bool operator==(const NodeValue& other) const;
+    bool operator!=(const NodeValue& other) const;
+    bool operator<(const NodeValue& other) const; // Numbers before strings
+
+private:
+    void retain() const;
+    void release() const;
+
+private:
+    std::variant<std::monostate, int64_t, double, uint32_t> mValue;
+};
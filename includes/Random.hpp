@@ -0,0 +1,38 @@
+#pragma once
+#include "../INIT.hpp"
+
+// xoshiro256** generator, one independent stream per user
+class RandomStream {
+public:
+    RandomStream();
+    RandomStream(uint64_t seed, uint64_t stream);
+
+    uint64_t next();
+    int nextInt(int min, int max); // Inclusive, without modulo bias
+    float nextFloat(float min, float max);
+
+private:
+    uint64_t mState[4];
+};
+
+// Owns the run's seed. Every scene derives its own stream from it, so the
+// same seed replays the same layouts and lists regardless of scene order.
+class RandomService {
+public:
+    static constexpr const char* SEED_ARGUMENT = "--seed";
+    static constexpr const char* SEED_VARIABLE = "ANIMATION_SEED";
+
+public:
+    // Seed from --seed N, --seed=N or ANIMATION_SEED, otherwise from the clock
+    static void init(int argc, char* argv[]);
+    static void setSeed(uint64_t seed);
+    static uint64_t getSeed();
+
+    static RandomStream stream(Scene scene);
+
+private:
+    static bool parseSeed(const char* text, uint64_t& seed);
+
+private:
+    static uint64_t sSeed;
+};
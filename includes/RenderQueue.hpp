@@ -0,0 +1,173 @@
+#pragma once
+#include "../INIT.hpp"
+
+enum class DrawOp : uint8_t {
+    Rectangle,
+    RectangleLines,
+    Circle,
+    Line,
+    Triangle,
+    Text,
+    Texture,
+    Triangles,
+    Lines,
+    Glyphs
+};
+
+// One recorded draw. The meaning of p[] depends on op:
+// Rectangle/RectangleLines x, y, width, height (, thickness), Circle x, y, radius,
+// Line x1, y1, x2, y2, thickness, Triangle three points, Text x, y, size,
+// Texture destination x, y, width, height, rotation, Glyphs x, y, size, spacing.
+// Triangles and Lines only use their run.
+struct RenderCommand {
+    DrawOp op;
+    uint8_t layer;
+    Color color;
+    float p[6];
+    uint32_t payload; // Text offset, texture slot or run
+};
+
+// Commands between two camera changes. Sorting never crosses a pass.
+struct RenderPass {
+    uint32_t first;
+    uint32_t count;
+    bool world;
+    Camera2D camera;
+};
+
+struct TextureSlot {
+    Texture2D texture;
+    Rectangle source;
+};
+
+struct RenderVertex {
+    float x, y;
+    Color color;
+};
+
+// Vertices of a Triangles or Lines command, codepoints of a Glyphs command
+struct RenderRun {
+    uint32_t first;
+    uint32_t count;
+    Font font; // Glyphs only
+};
+
+class RenderQueue;
+
+class RenderBackend {
+public:
+    virtual ~RenderBackend() = default;
+    virtual void submit(const RenderQueue& queue) = 0;
+};
+
+// Draws through raylib
+class RaylibBackend : public RenderBackend {
+public:
+    static constexpr int CHUNK_VERTICES = 3 * 1024; // Submitted per batch limit check
+
+public:
+    void submit(const RenderQueue& queue) override;
+
+private:
+    void drawVertices(int mode, const RenderVertex* vertices, uint32_t count);
+};
+
+// Draws nothing, only counts what it was given
+class NullBackend : public RenderBackend {
+public:
+    NullBackend();
+    void submit(const RenderQueue& queue) override;
+    void reset();
+
+    int getFrames() const;
+    long long getCommands() const;
+    long long getCommands(DrawOp op) const;
+    long long getBatches() const;
+    long long getVertices() const; // Of Triangles and Lines runs
+
+private:
+    int mFrames;
+    long long mCommands;
+    long long mBatches;
+    long long mVertices;
+    long long mCommandsByOp[static_cast<int>(DrawOp::Glyphs) + 1];
+};
+
+// Per-frame command buffer. Scenes record into it, flush() sorts every pass by
+// layer and then by batch state (shapes, text, each texture) and hands it to a
+// backend. Within one layer the order is free, so overlapping draws that depend
+// on each other go on different layers.
+class RenderQueue {
+public:
+    enum Layer : uint8_t {
+        LAYER_BACKGROUND = 0,
+        LAYER_SHAPES     = 1,
+        LAYER_OUTLINES   = 2,
+        LAYER_TEXT       = 3,
+        LAYER_OVERLAY    = 4,
+    };
+
+public:
+    RenderQueue();
+
+    void setLayer(uint8_t layer);
+    uint8_t getLayer() const;
+    void beginWorld(const Camera2D& camera); // Following commands use the camera
+    void endWorld();
+
+    void rectangle(Rectangle rect, Color color);
+    void rectangleLines(Rectangle rect, float thickness, Color color);
+    void circle(Vector2 center, float radius, Color color);
+    void line(Vector2 start, Vector2 end, float thickness, Color color);
+    void triangle(Vector2 a, Vector2 b, Vector2 c, Color color);
+    void text(const char* text, int x, int y, int size, Color color);
+    void texture(Texture2D texture, Rectangle source, Rectangle dest, Color color, float rotation = 0.0f);
+    // Raw geometry for batched renderers. The caller fills the count returned
+    // vertices before recording anything else: every three make a triangle,
+    // every two a line.
+    RenderVertex* triangles(uint32_t count);
+    RenderVertex* lines(uint32_t count);
+    // Decoded text in any font, see TextRun
+    void glyphs(Font font, const int* codepoints, int count, Vector2 position, float size, float spacing, Color color);
+
+    // Sorts, submits and clears
+    void flush(RenderBackend& backend);
+    void clear();
+
+    // Read by backends during submit
+    const std::vector<RenderPass>& getPasses() const;
+    const std::vector<uint32_t>& getOrder() const; // Sorted command indices per pass
+    const RenderCommand& getCommand(uint32_t index) const;
+    const char* getText(uint32_t offset) const;
+    const TextureSlot& getTexture(uint32_t slot) const;
+    const RenderRun& getRun(uint32_t run) const;
+    const RenderVertex* getVertices(const RenderRun& run) const;
+    const int* getCodepoints(const RenderRun& run) const;
+
+    // Statistics of the last flush
+    int getCommandCount() const;
+    int getBatchCount() const;         // State changes a backend has to make
+    int getUnsortedBatchCount() const; // The same in recorded order
+
+private:
+    RenderCommand& push(DrawOp op, Color color);
+    RenderVertex* pushVertices(DrawOp op, uint32_t count);
+    uint32_t batchOf(const RenderCommand& command) const;
+    int countBatches(bool sorted) const;
+
+private:
+    std::vector<RenderCommand> mCommands;
+    std::vector<RenderPass> mPasses;
+    std::vector<uint32_t> mOrder;
+    std::vector<uint64_t> mKeys;
+    std::vector<char> mText;
+    std::vector<TextureSlot> mTextures;
+    std::vector<RenderRun> mRuns;
+    std::vector<RenderVertex> mVertices;
+    std::vector<int> mCodepoints;
+    uint8_t mLayer;
+
+    int mCommandCount;
+    int mBatchCount;
+    int mUnsortedBatchCount;
+};
@@ -0,0 +1,57 @@
+#pragma once
+#include "../INIT.hpp"
+
+// Uniform hash grid over axis-aligned boxes, items are dense integer ids.
+// Moving an item only touches the grid when it crosses a cell boundary.
+class SpatialGrid {
+public:
+    explicit SpatialGrid(float cellSize = 100.0f);
+
+    void setCellSize(float cellSize);
+    float getCellSize() const;
+
+    // Item management
+    void insert(int id, Rectangle bounds);
+    void update(int id, Rectangle bounds);
+    void remove(int id);
+    void clear();
+    bool contains(int id) const;
+    Rectangle getBounds(int id) const;
+
+    // Queries append the ids of items whose box overlaps the query, each id once
+    void queryPoint(Vector2 point, std::vector<int>& result) const;
+    void queryRadius(Vector2 center, float radius, std::vector<int>& result) const;
+    void queryRect(Rectangle area, std::vector<int>& result) const;
+
+    static Rectangle circleBounds(Vector2 center, float radius);
+
+private:
+    struct CellRange {
+        int minX, minY, maxX, maxY;
+
+        bool operator==(const CellRange& range) const
+        {
+            return minX == range.minX && minY == range.minY && maxX == range.maxX && maxY == range.maxY;
+        }
+    };
+
+    struct Item {
+        Rectangle bounds;
+        CellRange cells;
+        bool active;
+    };
+
+    CellRange cellRange(Rectangle bounds) const;
+    static uint64_t cellKey(int x, int y);
+    void link(int id, const CellRange& cells);
+    void unlink(int id, const CellRange& cells);
+
+private:
+    float mCellSize;
+    std::unordered_map<uint64_t, std::vector<int>> mCells;
+    std::vector<Item> mItems;
+
+    // Per-item query stamps to report multi-cell items only once
+    mutable std::vector<uint32_t> mStamps;
+    mutable uint32_t mQueryStamp;
+};
@@ -0,0 +1,71 @@
+#pragma once
+#include "../INIT.hpp"
+#include "../includes/RenderQueue.hpp"
+
+// Shared text measurements keyed by (font, size, spacing, string).
+// Holds at most CAPACITY entries, the least recently used one goes first.
+class TextCache {
+public:
+    static constexpr size_t CAPACITY = 4096;
+
+public:
+    static Vector2 measure(Font font, const std::string& text, float fontSize, float spacing);
+    static void clear();
+    static size_t size();
+
+private:
+    struct Extent {
+        std::string key;
+        Vector2 size;
+    };
+
+    static std::list<Extent> sRecent; // Most recently used first
+    static std::unordered_map<std::string, std::list<Extent>::iterator> sExtents;
+};
+
+// A string with its measured size and decoded glyphs, without the font itself.
+// For owners that keep their font elsewhere, e.g. in a shared style table.
+class TextRun {
+public:
+    TextRun();
+
+    void setText(const std::string& text, Font font, float fontSize, float spacing);
+    void remeasure(Font font, float fontSize, float spacing);
+
+    const std::string& getText() const;
+    bool empty() const;
+    Vector2 getSize() const;
+
+    // Records the glyphs with the top-left corner at position
+    void draw(RenderQueue& queue, Font font, float fontSize, float spacing, Vector2 position, Color color) const;
+
+private:
+    std::string mText;
+    std::vector<int> mCodepoints; // Glyph run for RenderQueue::glyphs
+    Vector2 mSize;
+};
+
+// A TextRun together with the font it is measured for, owned by whatever draws it.
+// Measuring and decoding happen when the text or font changes, never while drawing.
+class TextLayout {
+public:
+    TextLayout();
+    TextLayout(Font font, float fontSize, float spacing);
+
+    void setText(const std::string& text);
+    void setFont(Font font, float fontSize, float spacing);
+
+    const std::string& getText() const;
+    bool empty() const;
+    Vector2 getSize() const;
+    float getFontSize() const;
+
+    // Records the glyphs with the top-left corner at position
+    void draw(RenderQueue& queue, Vector2 position, Color color) const;
+
+private:
+    TextRun mRun;
+    Font mFont;
+    float mFontSize;
+    float mSpacing;
+};
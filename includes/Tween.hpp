@@ -0,0 +1,41 @@
+#pragma once
+#include "../INIT.hpp"
+
+enum class Ease : uint8_t {
+    Linear,
+    InQuad,
+    OutQuad,
+    InOutQuad,
+    OutCubic,
+    InOutCubic,
+    Count,
+};
+
+// Keyframe tracks stored as parallel arrays. A track eases one float from a start
+// to an end value and writes it through its target pointer. Tracks are added
+// while setting up an animation, evaluating them never allocates.
+class TweenPool {
+public:
+    TweenPool();
+
+    void reserve(size_t tracks);
+    void clear(); // Keeps the capacity for the next animation
+    size_t size() const;
+
+    // Returns the index of the (first) new track
+    uint32_t add(float* target, float from, float to, Ease ease = Ease::Linear);
+    uint32_t add(Vector2* target, Vector2 from, Vector2 to, Ease ease = Ease::Linear);
+
+    // Evaluates tracks [first, first + count) at progress in [0, 1]
+    void evaluate(uint32_t first, uint32_t count, float progress);
+    float getValue(uint32_t track) const;
+
+    static float ease(Ease ease, float t);
+
+private:
+    std::vector<float*> mTargets; // May be null, the value is then only kept in mValues
+    std::vector<float> mFrom;
+    std::vector<float> mDelta;
+    std::vector<uint8_t> mEase;
+    std::vector<float> mValues;
+};
@@ -2,6 +2,8 @@
 #include "../INIT.hpp"
 #include "../includes/Utility.hpp"
 #include "../includes/Button.hpp"
+#include "../includes/RenderQueue.hpp"
+#include "../includes/AssetManager.hpp"
 
 class SceneComponent {
 public:
@@ -12,6 +14,7 @@ public:
     virtual void draw()               = 0;
     virtual void handleWindowResize() = 0;
     virtual void clean()              = 0;
+    virtual bool hasChanged() const { return false; } // Draws differently since the last update
 };
 
 class ReturnButtonComponent : public SceneComponent {
@@ -41,6 +44,7 @@ private:
     Vector2 lastMousePosition;
     float minZoom;
     float maxZoom;
+    bool changed;
 
 public:
     Camera2DComponent();
@@ -50,6 +54,7 @@ public:
     void draw() override; // This doesn't draw anything
     void handleWindowResize() override;
     void clean() override;
+    bool hasChanged() const override;
 
     // Camera control methods
     void beginMode();
@@ -59,6 +64,9 @@ public:
     // Transform methods
     Vector2 screenToWorld(Vector2 position);
     Vector2 worldToScreen(Vector2 position);
+    Rectangle getWorldRect(); // Part of the world currently on screen
+    float getZoom() const;
+    const Camera2D& getCamera() const;
 };
 
 // =========================================================
@@ -68,14 +76,21 @@ protected:
     int baseFontSize;
     int titleFontSize;
     std::vector<std::unique_ptr<SceneComponent>> components;
+    bool dirty = true;
 
 public:
     SceneManager();
     virtual ~SceneManager();
     virtual void init()   = 0;
-    virtual void update() = 0;
+    virtual void update() = 0; // Once per frame: input and anything tied to drawing
     virtual void draw()   = 0;
     virtual void clean()  = 0;
+    virtual void fixedUpdate(float /*dt*/) {} // Once per simulation tick of dt seconds
+    virtual void loadDemo() {}                // Sample content for exports
+    virtual bool isAnimating() const { return false; } // Changes every frame without input
+
+    void markDirty();  // Something visible changed, the next frame is redrawn
+    bool takeDirty();  // True if the scene has to be redrawn, clears the flag
 
     void updateFontSize();
 
@@ -98,13 +113,19 @@ public:
 
 class Title : public SceneManager {
 private:
-    Texture2D background;
+    static constexpr const char* BACKGROUND_PATH = "images/a_ship_in_the_water.jpg";
+    static constexpr int PULSE_CYCLES            = 3; // Of the guide text after showing or mouse input, then it holds still
+    Texture2D background = {};
+    bool backgroundReady = false; // Uploaded, or failed to decode
+    double pulseStart    = 0.0;
+    bool pulsing         = false;
 
 public:
     void init() override;
     void update() override;
     void draw() override;
     void clean() override;
+    bool isAnimating() const override; // While the guide text pulses or the background loads
 };
 
 class Menu : public SceneManager {
@@ -120,14 +141,44 @@ public:
 
 // =========================================================
 
+struct ExportOptions;
+
 class Application {
 private:
+    AssetManager assets; // Before the scenes, their textures are released into it
     std::vector<std::unique_ptr<SceneManager>> scenes;
     SceneManager* currentScene = nullptr;
     static Application* instance;
     static float lastSceneChangeTime;
 
+    // Fixed timestep simulation
+    float tickRate    = DEFAULT_TICK_RATE;
+    int maxCatchUp    = DEFAULT_MAX_CATCH_UP;
+    float accumulator = 0.0f;
+    float alpha       = 0.0f;
+    float frameDelta  = 0.0f; // Seconds covered by the current per-frame update
+
+    // Scenes record into the queue, draw() submits it to the backend
+    RenderQueue renderQueue;
+    std::unique_ptr<RenderBackend> renderBackend;
+
+    // Retained rendering, the last frame is kept and redrawn only on change
+    RenderTexture2D frame = {};
+    bool idle             = false;
+    int redrawnFrames     = 0;
+    std::chrono::steady_clock::time_point startTime; // For the time to the first frame
+
+    bool hasInput() const;
+
+    void switchScene(Scene newScene);
+    void stepExportFrame(); // One tick and the per-frame update, drawn at the tick itself
+    bool countCommands(const ExportOptions& options);
+
 public:
+    static constexpr float DEFAULT_TICK_RATE  = 60.0f;
+    static constexpr int DEFAULT_MAX_CATCH_UP = 5;    // Ticks per frame before time is dropped
+    static constexpr float MAX_FRAME_DELTA    = 0.1f; // Per-frame updates see no longer frames, e.g. after an idle wait
+
     Application();
     ~Application();
 
@@ -135,8 +186,26 @@ public:
 
     SceneManager* getCurScene();
     void changeScene(Scene newScene);
-    void update();
+    void update(); // Runs the due simulation ticks, then the per-frame update
     void draw();
+    void render(); // Redraws the kept frame if anything changed and puts it on screen
+    void simulate(int ticks); // Ticks right away, e.g. to run ahead of real time
+    // Renders options.frames frames offscreen, one tick each, and writes them as images,
+    // or with options.count only logs the draw commands recorded per frame
+    bool exportFrames(const ExportOptions& options);
+
+    void setTickRate(float ticksPerSecond);
+    float getTickRate() const;
+    float getTickDelta() const;
+    void setMaxCatchUp(int ticks);
+    float getAlpha() const;      // Progress towards the next tick, for interpolated drawing
+    float getFrameDelta() const; // Use instead of GetFrameTime(), exports advance one tick per frame
+
+    AssetManager& getAssets();
+    RenderQueue& getRenderQueue();
+    void setRenderBackend(std::unique_ptr<RenderBackend> backend); // E.g. a NullBackend to count commands
+    bool isIdle() const;                                           // Waiting for events, nothing to redraw
+    int getRedrawnFrames() const;
 
     static bool canChangeScene();
     static constexpr float sceneChangeCooldown = 0.5f; // 0.5 second cooldown 
@@ -1,15 +1,27 @@
 ﻿#include "INIT.hpp"
 #include "includes/UI.hpp"
+#include "includes/Random.hpp"
+#include "includes/FrameExporter.hpp"
+
+int main(int argc, char* argv[]) {
+    // Seed before any scene takes its random stream
+    RandomService::init(argc, argv);
+
+    // Export and count modes render offscreen, the window stays hidden
+    ExportOptions exportOptions;
+    bool exporting = FrameExporter::parseArguments(argc, argv, exportOptions);
+    if (exporting)
+        SetConfigFlags(FLAG_WINDOW_HIDDEN);
 
-int main() {
     // There's constructor and destructor for Application
     Application app;
+    if (exporting)
+        return app.exportFrames(exportOptions) ? 0 : 1;
+
     while (!WindowShouldClose()) {
-        app.getCurScene()->update();
+        app.update();
         BeginDrawing();
-        ClearBackground(RAYWHITE);
-        DrawCircle(0, 0, 30, RED);
-        app.getCurScene()->draw();
+        app.render();
         DrawFPS(GetScreenWidth() - 100, GetScreenHeight() - 50);
         EndDrawing();
     }
@@ -4,17 +4,59 @@
 
 // public
 Animation::Animation(const std::function<void(float)>& forward, float duration)
-    : mForward(forward), mBackward(nullptr), mDuration(duration), mElapsed(0.0f), mDirection(Direction::Forward) {}
+    : mForward(forward), mBackward(nullptr), mTweens(nullptr), mFirstTrack(0), mTrackCount(0), mSchedule(nullptr),
+      mDuration(duration), mElapsed(0.0f), mDirection(Direction::Forward) {}
 
 Animation::Animation(const std::function<void(float)>& forward, const std::function<void(float)>& backward, float duration)
-    : mForward(forward), mBackward(backward), mDuration(duration), mElapsed(0.0f), mDirection(Direction::Forward) {}
+    : mForward(forward), mBackward(backward), mTweens(nullptr), mFirstTrack(0), mTrackCount(0), mSchedule(nullptr),
+      mDuration(duration), mElapsed(0.0f), mDirection(Direction::Forward) {}
+
+Animation::Animation(TweenPool& tweens, uint32_t firstTrack, uint32_t trackCount, float duration)
+    : mForward(nullptr), mBackward(nullptr), mTweens(&tweens), mFirstTrack(firstTrack), mTrackCount(trackCount), mSchedule(nullptr),
+      mDuration(duration), mElapsed(0.0f), mDirection(Direction::Forward) {}
+
+Animation::Animation(const std::shared_ptr<AnimationSchedule>& schedule)
+    : mForward(nullptr), mBackward(nullptr), mTweens(nullptr), mFirstTrack(0), mTrackCount(0), mSchedule(schedule),
+      mDuration(schedule->getDuration()), mElapsed(0.0f), mDirection(Direction::Forward) {}
+
+Animation::Animation(const Animation& other)
+    : mForward(other.mForward), mBackward(other.mBackward), mTweens(other.mTweens), mFirstTrack(other.mFirstTrack),
+      mTrackCount(other.mTrackCount), mSchedule(other.mSchedule ? std::make_shared<AnimationSchedule>(*other.mSchedule) : nullptr),
+      mDuration(other.mDuration), mElapsed(other.mElapsed), mDirection(other.mDirection) {}
+
+Animation& Animation::operator=(const Animation& other)
+{
+    if (this != &other) {
+        *this = Animation(other);
+    }
+    return *this;
+}
 
 void Animation::update(float dt)
 {
     mElapsed += dt;
+    apply();
+}
+
+void Animation::seek(float elapsed)
+{
+    mElapsed = elapsed;
+    apply();
+}
+
+// private
+void Animation::apply()
+{
     float progress = std::min(1.0f, mElapsed / mDuration);
 
-    if (mDirection == Direction::Forward && mForward) {
+    if (mSchedule) {
+        float time = std::min(mElapsed, mDuration);
+        mSchedule->evaluate(mDirection == Direction::Forward ? time : mDuration - time, mDirection);
+    }
+    else if (mTweens) {
+        mTweens->evaluate(mFirstTrack, mTrackCount, mDirection == Direction::Forward ? progress : 1.0f - progress);
+    }
+    else if (mDirection == Direction::Forward && mForward) {
         mForward(progress);
     }
     else if (mDirection == Direction::Backward && mBackward) {
@@ -42,6 +84,145 @@ float Animation::getDuration() const
     return mDuration;
 }
 
+// AnimationSchedule implementation
+// =========================================================
+
+AnimationSchedule::AnimationSchedule()
+    : mDuration(0.0f), mLastTime(0.0f) {}
+
+void AnimationSchedule::add(float start, const Animation& animation)
+{
+    mEntries.push_back({start, animation.getDuration(), false, animation});
+    mDuration = std::max(mDuration, start + animation.getDuration());
+}
+
+void AnimationSchedule::sort()
+{
+    std::stable_sort(mEntries.begin(), mEntries.end(),
+                     [](const Entry& a, const Entry& b) { return a.start < b.start; });
+}
+
+float AnimationSchedule::getDuration() const
+{
+    return mDuration;
+}
+
+size_t AnimationSchedule::size() const
+{
+    return mEntries.size();
+}
+
+void AnimationSchedule::evaluate(float time, Direction direction)
+{
+    // Going back in time: entries that start later return to their start,
+    // latest first so earlier entries on the same target win, and the ones
+    // running at time live again
+    if (time < mLastTime) {
+        for (auto it = mEntries.rbegin(); it != mEntries.rend(); ++it) {
+            if (it->start > time && it->start <= mLastTime) {
+                seekEntry(*it, 0.0f, direction);
+                it->done = false;
+            }
+            else if (it->start + it->duration > time) {
+                it->done = false;
+            }
+        }
+    }
+    mLastTime = time;
+
+    for (auto& entry : mEntries) {
+        if (entry.start > time) {
+            break; // Sorted, nothing later has started
+        }
+        if (entry.done) {
+            continue;
+        }
+
+        float local = time - entry.start;
+        if (local >= entry.duration) {
+            seekEntry(entry, entry.duration, direction);
+            entry.done = true;
+        }
+        else {
+            seekEntry(entry, local, direction);
+        }
+    }
+}
+
+void AnimationSchedule::seekEntry(Entry& entry, float local, Direction direction)
+{
+    // A backward entry has run for the part of it that lies after local
+    entry.animation.setDirection(direction);
+    entry.animation.seek(direction == Direction::Forward ? local : entry.duration - local);
+}
+
+// AnimationGroup implementation
+// =========================================================
+
+AnimationGroup::AnimationGroup(const Animation& animation)
+    : mKind(Single), mAnimation(std::make_shared<Animation>(animation)), mDuration(animation.getDuration()) {}
+
+AnimationGroup::AnimationGroup(Kind kind, const std::vector<AnimationGroup>& children)
+    : mKind(kind), mAnimation(nullptr), mChildren(children), mDuration(0.0f)
+{
+    for (const auto& child : mChildren) {
+        if (mKind == Sequence) {
+            mDuration += child.getDuration();
+        }
+        else {
+            mDuration = std::max(mDuration, child.getDuration());
+        }
+    }
+}
+
+AnimationGroup AnimationGroup::sequence(const std::vector<AnimationGroup>& children)
+{
+    return AnimationGroup(Sequence, children);
+}
+
+AnimationGroup AnimationGroup::parallel(const std::vector<AnimationGroup>& children)
+{
+    return AnimationGroup(Parallel, children);
+}
+
+AnimationGroup::Kind AnimationGroup::getKind() const
+{
+    return mKind;
+}
+
+float AnimationGroup::getDuration() const
+{
+    return mDuration;
+}
+
+Animation AnimationGroup::build() const
+{
+    auto schedule = std::make_shared<AnimationSchedule>();
+    flatten(0.0f, *schedule);
+    schedule->sort();
+    return Animation(schedule);
+}
+
+void AnimationGroup::flatten(float start, AnimationSchedule& schedule) const
+{
+    switch (mKind) {
+        case Single:
+            schedule.add(start, *mAnimation);
+            break;
+        case Sequence:
+            for (const auto& child : mChildren) {
+                child.flatten(start, schedule);
+                start += child.getDuration();
+            }
+            break;
+        case Parallel:
+            for (const auto& child : mChildren) {
+                child.flatten(start, schedule);
+            }
+            break;
+    }
+}
+
 // AnimationList implementation
 // =========================================================
 
@@ -56,9 +237,12 @@ void AnimationList::proceedToNext()
     }
     else {
         mIsPlaying = false;
+        mTime      = mTotalDuration;
         return;
     }
     mList[mCurrentAnimation].reset();
+    mTime = mStartTimes[mCurrentAnimation];
+    saveCheckpoint(mCurrentAnimation);
 }
 
 void AnimationList::proceedToPrevious()
@@ -70,12 +254,40 @@ void AnimationList::proceedToPrevious()
         mCurrentAnimation--;
     }
     mList[mCurrentAnimation].reset();
+    mTime = mStartTimes[mCurrentAnimation];
+}
+
+void AnimationList::rebuildTimeline()
+{
+    mStartTimes.clear();
+    mTotalDuration = 0.0f;
+    for (const auto& anim : mList) {
+        mStartTimes.push_back(mTotalDuration);
+        mTotalDuration += anim.getDuration() + mCooldown;
+    }
+}
+
+void AnimationList::saveCheckpoint(unsigned int animation)
+{
+    if (!mSaveCheckpoint || mCheckpointInterval == 0 || animation % mCheckpointInterval != 0) {
+        return;
+    }
+
+    unsigned int checkpoint = animation / mCheckpointInterval;
+    if (checkpoint >= mCheckpointSaved.size()) {
+        mCheckpointSaved.resize(checkpoint + 1, false);
+    }
+    if (!mCheckpointSaved[checkpoint]) {
+        mSaveCheckpoint(checkpoint);
+        mCheckpointSaved[checkpoint] = true;
+    }
 }
 
 // public
 AnimationList::AnimationList()
     : mCurrentAnimation(0), mCooldown(0.0f), mDelayTimer(0.0f),
-      mSpeed(1.0f), mIsPlaying(false), mLooping(false), mWaiting(false) {}
+      mSpeed(1.0f), mIsPlaying(false), mLooping(false), mWaiting(false), mInstant(false),
+      mTotalDuration(0.0f), mTime(0.0f), mCheckpointInterval(0) {}
 
 bool AnimationList::isFinished() const
 {
@@ -112,16 +324,57 @@ bool AnimationList::isLooping() const
     return mLooping;
 }
 
+bool AnimationList::isInstant() const
+{
+    return mInstant;
+}
+
+float AnimationList::getTime() const
+{
+    return mTime;
+}
+
+float AnimationList::getTotalDuration() const
+{
+    return mTotalDuration;
+}
+
+unsigned int AnimationList::findAnimation(float time) const
+{
+    if (mStartTimes.empty()) {
+        return 0;
+    }
+
+    // Last animation starting at or before time
+    auto it = std::upper_bound(mStartTimes.begin(), mStartTimes.end(), time);
+    return it == mStartTimes.begin() ? 0 : static_cast<unsigned int>(it - mStartTimes.begin() - 1);
+}
+
 void AnimationList::push(const Animation& animation)
 {
     mList.push_back(animation);
+    mStartTimes.push_back(mTotalDuration);
+    mTotalDuration += animation.getDuration() + mCooldown;
+    if (mList.size() == 1) {
+        saveCheckpoint(0); // Seeking needs the state before the first animation
+    }
+}
+
+void AnimationList::push(const AnimationGroup& group)
+{
+    push(group.build());
 }
 
 void AnimationList::clear()
 {
     mList.clear();
+    mStartTimes.clear();
+    mCheckpointSaved.clear();
     mCurrentAnimation = 0;
     mIsPlaying        = false;
+    mWaiting          = false;
+    mTotalDuration    = 0.0f;
+    mTime             = 0.0f;
 }
 
 void AnimationList::play()
@@ -134,6 +387,7 @@ void AnimationList::play()
                 anim.reset();
             }
         }
+        saveCheckpoint(mCurrentAnimation);
     }
 }
 
@@ -163,6 +417,7 @@ void AnimationList::goToFront()
     if (!mList.empty()) {
         mCurrentAnimation = 0;
         mList[0].reset();
+        mTime = 0.0f;
     }
 }
 
@@ -171,6 +426,7 @@ void AnimationList::goToBack()
     if (!mList.empty()) {
         mCurrentAnimation = mList.size() - 1;
         mList.back().reset();
+        mTime = mStartTimes.back();
     }
 }
 
@@ -187,13 +443,90 @@ void AnimationList::setLooping(bool looping)
 void AnimationList::setCooldown(float cooldown)
 {
     mCooldown = cooldown;
+    rebuildTimeline();
+}
+
+void AnimationList::setInstant(bool instant)
+{
+    mInstant = instant;
+}
+
+void AnimationList::finish()
+{
+    // Nothing left, don't apply the last state twice
+    if (mList.empty() || (!mIsPlaying && mTime >= mTotalDuration)) {
+        return;
+    }
+
+    seek(mTotalDuration);
+    mWaiting   = false;
+    mIsPlaying = false;
+}
+
+void AnimationList::setCheckpoints(unsigned int interval, const std::function<void(unsigned int)>& save,
+                                   const std::function<void(unsigned int)>& restore)
+{
+    mCheckpointInterval = interval;
+    mSaveCheckpoint     = save;
+    mRestoreCheckpoint  = restore;
+    mCheckpointSaved.clear();
+    if (!mList.empty() && mCurrentAnimation == 0 && mTime == 0.0f) {
+        saveCheckpoint(0);
+    }
+}
+
+void AnimationList::seek(float time)
+{
+    if (mList.empty()) {
+        return;
+    }
+
+    time                = std::max(0.0f, std::min(time, mTotalDuration));
+    unsigned int target = findAnimation(time);
+
+    // Forward seeks can carry on from the current animation, backward ones
+    // start from the nearest saved checkpoint at or before the target
+    bool forward       = target >= mCurrentAnimation;
+    unsigned int first = forward ? mCurrentAnimation : target;
+    if (mRestoreCheckpoint && mCheckpointInterval > 0) {
+        unsigned int checkpoint = std::min<unsigned int>(target / mCheckpointInterval, mCheckpointSaved.size());
+        while (checkpoint > 0 && (checkpoint >= mCheckpointSaved.size() || !mCheckpointSaved[checkpoint])) {
+            checkpoint--;
+        }
+        bool saved = checkpoint < mCheckpointSaved.size() && mCheckpointSaved[checkpoint];
+        if (saved && (!forward || checkpoint * mCheckpointInterval > mCurrentAnimation)) {
+            mRestoreCheckpoint(checkpoint);
+            first = checkpoint * mCheckpointInterval;
+        }
+    }
+
+    // Complete the animations in between, saving checkpoints on the way
+    for (unsigned int i = first; i < target; i++) {
+        mList[i].seek(mList[i].getDuration());
+        saveCheckpoint(i + 1);
+    }
+
+    float local    = time - mStartTimes[target];
+    float duration = mList[target].getDuration();
+    mList[target].seek(std::min(local, duration));
+
+    mCurrentAnimation = target;
+    mTime             = time;
+    mWaiting          = mCooldown > 0.0f && local >= duration;
+    mDelayTimer       = mWaiting ? local - duration : 0.0f;
 }
 
 void AnimationList::update(float dt)
 {
+    if (mInstant && mIsPlaying) {
+        finish();
+        return;
+    }
+
     if (mIsPlaying && !mList.empty()) {
         if (!mWaiting) {
             float adjustedDt = dt * mSpeed;
+            mTime += adjustedDt;
             mList[mCurrentAnimation].update(adjustedDt);
 
             if (mList[mCurrentAnimation].isFinished()) {
@@ -208,6 +541,7 @@ void AnimationList::update(float dt)
         }
         else {
             mDelayTimer += dt;
+            mTime += dt;
             if (mDelayTimer >= mCooldown) {
                 mWaiting = false;
                 proceedToNext();
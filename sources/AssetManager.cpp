@@ -0,0 +1,295 @@
+#include "../includes/AssetManager.hpp"
+
+namespace {
+    using Clock = std::chrono::steady_clock;
+
+    double millisecondsSince(Clock::time_point start)
+    {
+        return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+    }
+}
+
+AssetManager::AssetManager()
+    : mClock(0),
+      mWarm(0),
+      mLoads(0),
+      mHits(0),
+      mJobOrder(0),
+      mStopping(false)
+{
+}
+
+AssetManager::~AssetManager()
+{
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        mStopping = true;
+    }
+    mHasJob.notify_all();
+    for (std::thread& worker : mWorkers)
+        worker.join();
+
+    for (auto& decode : mDecodes) {
+        if (decode.second.state == Decode::DECODED)
+            UnloadImage(decode.second.image);
+    }
+    clear();
+}
+
+bool AssetManager::Job::operator<(const Job& other) const
+{
+    if (priority != other.priority)
+        return priority < other.priority;
+    return order > other.order;
+}
+
+void AssetManager::preload(const std::string& path, int priority)
+{
+    if (mEntries.count(path))
+        return;
+
+    std::lock_guard<std::mutex> lock(mMutex);
+    enqueue(path, priority);
+}
+
+void AssetManager::enqueue(const std::string& path, int priority)
+{
+    auto it = mDecodes.find(path);
+    if (it != mDecodes.end()) {
+        // Raised priorities are queued again, workers skip the stale job
+        if (it->second.state != Decode::QUEUED || priority <= it->second.priority)
+            return;
+        it->second.priority = priority;
+    }
+    else {
+        mDecodes.emplace(path, Decode{Decode::QUEUED, priority, Image{}, 0.0});
+    }
+
+    if (mWorkers.empty()) {
+        int workers = std::max(1, std::min(DECODE_WORKERS, static_cast<int>(std::thread::hardware_concurrency())));
+        for (int i = 0; i < workers; i++)
+            mWorkers.emplace_back(&AssetManager::decodeLoop, this);
+    }
+    mJobs.push(Job{priority, mJobOrder++, path});
+    mHasJob.notify_one();
+}
+
+void AssetManager::decodeLoop()
+{
+    std::unique_lock<std::mutex> lock(mMutex);
+    while (true) {
+        mHasJob.wait(lock, [this] { return mStopping || !mJobs.empty(); });
+        if (mStopping)
+            return;
+
+        Job job = mJobs.top();
+        mJobs.pop();
+        auto it = mDecodes.find(job.path);
+        if (it == mDecodes.end() || it->second.state != Decode::QUEUED)
+            continue; // Taken by the main thread or a stale duplicate
+        it->second.state = Decode::DECODING;
+
+        lock.unlock();
+        Clock::time_point start = Clock::now();
+        Image image             = LoadImage(job.path.c_str());
+        double milliseconds     = millisecondsSince(start);
+        lock.lock();
+
+        // Only the main thread erases, and never while decoding
+        Decode& decode      = mDecodes.at(job.path);
+        decode.image        = image;
+        decode.milliseconds = milliseconds;
+        decode.state        = image.data != nullptr ? Decode::DECODED : Decode::FAILED;
+        mDecoded.notify_all();
+    }
+}
+
+void AssetManager::update(double budget)
+{
+    Clock::time_point start = Clock::now();
+    while (millisecondsSince(start) < budget * 1000.0) {
+        std::string path;
+        Decode decode;
+        {
+            // Decoded images go up in priority order too
+            std::lock_guard<std::mutex> lock(mMutex);
+            auto next = mDecodes.end();
+            for (auto it = mDecodes.begin(); it != mDecodes.end(); ++it) {
+                if (it->second.state == Decode::DECODED && (next == mDecodes.end() || it->second.priority > next->second.priority))
+                    next = it;
+            }
+            if (next == mDecodes.end())
+                return;
+
+            path   = next->first;
+            decode = next->second;
+            mDecodes.erase(next);
+        }
+        upload(path, decode.image, decode.milliseconds, 0);
+    }
+}
+
+bool AssetManager::reference(const std::string& path, Texture2D& texture)
+{
+    auto it = mEntries.find(path);
+    if (it == mEntries.end())
+        return false;
+
+    if (it->second.references++ == 0)
+        mWarm--;
+    mHits++;
+    texture = it->second.texture;
+    return true;
+}
+
+Texture2D AssetManager::acquire(const std::string& path)
+{
+    Texture2D texture = {};
+    if (reference(path, texture))
+        return texture;
+
+    std::unique_lock<std::mutex> lock(mMutex);
+    auto it = mDecodes.find(path);
+    if (it != mDecodes.end() && it->second.state == Decode::DECODING) {
+        mDecoded.wait(lock, [&] { return mDecodes.at(path).state != Decode::DECODING; });
+        it = mDecodes.find(path);
+    }
+
+    if (it != mDecodes.end() && it->second.state != Decode::QUEUED) {
+        Decode decode = it->second;
+        mDecodes.erase(it);
+        lock.unlock();
+        if (decode.state == Decode::FAILED)
+            return texture;
+        return upload(path, decode.image, decode.milliseconds, 1);
+    }
+
+    // Not started yet, decoding here is quicker than waiting for the queue
+    if (it != mDecodes.end())
+        mDecodes.erase(it);
+    lock.unlock();
+
+    Clock::time_point start = Clock::now();
+    Image image             = LoadImage(path.c_str());
+    return upload(path, image, millisecondsSince(start), 1);
+}
+
+bool AssetManager::tryAcquire(const std::string& path, Texture2D& texture)
+{
+    texture = Texture2D{};
+    if (reference(path, texture))
+        return true;
+
+    std::unique_lock<std::mutex> lock(mMutex);
+    auto it = mDecodes.find(path);
+    if (it == mDecodes.end()) {
+        enqueue(path, PRIORITY_HIGH);
+        return false;
+    }
+    if (it->second.state == Decode::QUEUED || it->second.state == Decode::DECODING)
+        return false;
+    if (it->second.state == Decode::FAILED) {
+        mDecodes.erase(it); // Reported once, asking again retries
+        return true;
+    }
+
+    Decode decode = it->second;
+    mDecodes.erase(it);
+    lock.unlock();
+    texture = upload(path, decode.image, decode.milliseconds, 1);
+    return true;
+}
+
+Texture2D AssetManager::upload(const std::string& path, Image image, double decodeMilliseconds, int references)
+{
+    Clock::time_point start = Clock::now();
+    Texture2D texture       = LoadTextureFromImage(image);
+    UnloadImage(image);
+    if (texture.id == 0)
+        return texture;
+
+    TraceLog(LOG_INFO, "ASSETS: %s decoded in %.1f ms, uploaded in %.1f ms",
+             path.c_str(), decodeMilliseconds, millisecondsSince(start));
+
+    mEntries.emplace(path, Entry{texture, references, references == 0 ? ++mClock : 0});
+    mPaths.emplace(texture.id, path);
+    mLoads++;
+    if (references == 0) {
+        mWarm++;
+        evict();
+    }
+    return texture;
+}
+
+void AssetManager::release(Texture2D texture)
+{
+    auto path = mPaths.find(texture.id);
+    if (texture.id == 0 || path == mPaths.end())
+        return;
+
+    Entry& entry = mEntries.at(path->second);
+    if (entry.references == 0 || --entry.references > 0)
+        return;
+
+    entry.releasedAt = ++mClock;
+    mWarm++;
+    evict();
+}
+
+void AssetManager::evict()
+{
+    // Few textures are warm at a time, a scan for the oldest is enough
+    while (mWarm > WARM_CAPACITY) {
+        auto oldest = mEntries.end();
+        for (auto it = mEntries.begin(); it != mEntries.end(); ++it) {
+            if (it->second.references == 0 && (oldest == mEntries.end() || it->second.releasedAt < oldest->second.releasedAt))
+                oldest = it;
+        }
+
+        UnloadTexture(oldest->second.texture);
+        mPaths.erase(oldest->second.texture.id);
+        mEntries.erase(oldest);
+        mWarm--;
+    }
+}
+
+void AssetManager::clear()
+{
+    for (auto& entry : mEntries)
+        UnloadTexture(entry.second.texture);
+
+    mEntries.clear();
+    mPaths.clear();
+    mWarm = 0;
+}
+
+int AssetManager::getLoadedCount() const
+{
+    return static_cast<int>(mEntries.size());
+}
+
+int AssetManager::getWarmCount() const
+{
+    return mWarm;
+}
+
+int AssetManager::getPendingCount()
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+    int pending = 0;
+    for (auto& decode : mDecodes) {
+        if (decode.second.state != Decode::FAILED)
+            pending++;
+    }
+    return pending;
+}
+
+int AssetManager::getLoads() const
+{
+    return mLoads;
+}
+
+int AssetManager::getHits() const
+{
+    return mHits;
+}
\ No newline at end of file
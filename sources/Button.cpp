@@ -3,12 +3,13 @@
 
 Button::Button(Rectangle bounds, const char* buttonText, int fontSize, Color normal, Color hover, Color click, Color textColor)
     : bounds(bounds),
-      text(buttonText),
-      fontSize(fontSize),
       normalColor(normal),
       hoverColor(hover),
       clickColor(click),
       textColor(textColor),
+      text(buttonText),
+      fontSize(fontSize),
+      textWidth(-1),
       isHovered(false)
 {
     fontSize = 20; // Default
@@ -57,27 +58,38 @@ void Button::setColors(Color normal, Color hover, Color text)
 
 void Button::setText(const char* buttonText)
 {
-    text = buttonText;
+    text      = buttonText;
+    textWidth = -1;
 }
 
 void Button::setFontSize(int size)
 {
-    fontSize = size;
+    if (fontSize != size) {
+        fontSize  = size;
+        textWidth = -1;
+    }
 }
 
 void Button::drawButtonBackground(Color boxColor)
 {
-    DrawRectangleRec(bounds, boxColor);
-    DrawRectangleLinesEx(bounds, 2, isHovered ? BLACK : DARKGRAY);
+    RenderQueue& queue = Application::getInstance()->getRenderQueue();
+    queue.setLayer(RenderQueue::LAYER_SHAPES);
+    queue.rectangle(bounds, boxColor);
+    queue.setLayer(RenderQueue::LAYER_OUTLINES);
+    queue.rectangleLines(bounds, 2, isHovered ? BLACK : DARKGRAY);
 }
 
 void Button::drawCenteredText(float yOffset)
 {
     if (text && text[0] != '\0') {
-        int textWidth = MeasureText(text, fontSize);
+        if (textWidth < 0) {
+            textWidth = MeasureText(text, fontSize);
+        }
         float textX   = bounds.x + (bounds.width - textWidth) * 0.5f;
         float textY   = bounds.y + (bounds.height - fontSize) * 0.5f + yOffset;
-        DrawText(text, static_cast<int>(textX), static_cast<int>(textY), fontSize, textColor);
+        RenderQueue& queue = Application::getInstance()->getRenderQueue();
+        queue.setLayer(RenderQueue::LAYER_TEXT);
+        queue.text(text, static_cast<int>(textX), static_cast<int>(textY), fontSize, textColor);
     }
 }
 
@@ -86,7 +98,7 @@ ChangeSceneButton::ChangeSceneButton(Rectangle bounds, const char* buttonText, i
     : Button(bounds, buttonText, fontSize, normalColor, hoverColor, clickColor, textColor),
       targetScene(destination), ownTexture(true), isBackButton(isBack)
 {
-    icon = LoadTexture(iconPath);
+    icon = Application::getInstance()->getAssets().acquire(iconPath);
     if (isBackButton) {
         fontSize = static_cast<int>(fontSize * 0.9f);
     }
@@ -95,7 +107,7 @@ ChangeSceneButton::ChangeSceneButton(Rectangle bounds, const char* buttonText, i
 ChangeSceneButton::~ChangeSceneButton()
 {
     if (ownTexture) {
-        UnloadTexture(icon);
+        Application::getInstance()->getAssets().release(icon);
     }
 }
 
@@ -116,8 +128,11 @@ void ChangeSceneButton::draw()
     }
 
     // Draw the icon and borders
-    DrawTexturePro(icon, Rectangle{0, 0, static_cast<float>(icon.width), static_cast<float>(icon.height)}, bounds, Vector2{0, 0}, 0.0f, boxColor);
-    DrawRectangleLinesEx(bounds, 2, isHovered ? BLACK : DARKGRAY);
+    RenderQueue& queue = Application::getInstance()->getRenderQueue();
+    queue.setLayer(RenderQueue::LAYER_SHAPES);
+    queue.texture(icon, Rectangle{0, 0, static_cast<float>(icon.width), static_cast<float>(icon.height)}, bounds, boxColor);
+    queue.setLayer(RenderQueue::LAYER_OUTLINES);
+    queue.rectangleLines(bounds, 2, isHovered ? BLACK : DARKGRAY);
 
     if (!isBackButton) 
         drawCenteredText(4.0f*fontSize);
@@ -135,11 +150,12 @@ void ChangeSceneButton::setTargetScene(Scene newTarget)
 
 void ChangeSceneButton::setIcon(const char* iconPath)
 {
+    AssetManager& assets = Application::getInstance()->getAssets();
     if (ownTexture) {
-        UnloadTexture(icon);
+        assets.release(icon);
     }
 
-    icon       = LoadTexture(iconPath);
+    icon       = assets.acquire(iconPath);
     ownTexture = true;
 }
 
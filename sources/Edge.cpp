@@ -6,17 +6,23 @@ Edge::Edge(PolyNode* from, PolyNode* to, int type)
       mTo(to),
       mType(type),
       mWeight(0),
+      mOutSlot(0),
+      mInSlot(0),
       mColor(BLACK),
       mHighlightColor(RED),
       mThickness(DEFAULT_THICKNESS),
       mHighlighted(false),
-      mLabel(""),
       mLabelOffset({0, 0}),
       mDestination({0, 0}),
       mTargetDestination({0, 0}),
       mTargetType(TargetType::Left),
       mIsCircular(false),
-      mAnimationSpeed(5.0f)
+      mAnimationSpeed(5.0f),
+      mDirty(true),
+      mStart({0, 0}),
+      mMidpoint({0, 0}),
+      mArrowLeft({0, 0}),
+      mArrowRight({0, 0})
 {
     // If the edge connects to a real node, calculate the destination point
     if (to) {
@@ -43,7 +49,8 @@ void Edge::setHighlight(bool highlight)
 
 void Edge::setType(int type)
 {
-    mType = type;
+    mType  = type;
+    mDirty = true;
 
     // Update circular flag
     mIsCircular = (type & EdgeType::Circular) != 0;
@@ -51,11 +58,10 @@ void Edge::setType(int type)
 
 void Edge::setWeight(int weight)
 {
+    // The weight is kept even when hidden, the Weighted flag decides whether it is shown
     mWeight = weight;
-
-    // If weight is set, make sure the type includes Weighted flag
-    if (weight != 0) {
-        mType |= EdgeType::Weighted;
+    if (mText) {
+        mText->weightStale = true;
     }
 }
 
@@ -67,7 +73,9 @@ void Edge::setThickness(float thickness)
 // Pointer-specific methods
 void Edge::setLabel(const std::string& label)
 {
-    mLabel = label;
+    if (mText || !label.empty()) {
+        text().label.setText(label);
+    }
 }
 
 void Edge::setLabelOffset(float x, float y)
@@ -96,6 +104,7 @@ void Edge::setTarget(PolyNode* node, TargetType type)
     if (node) {
         mTargetDestination = calculateTargetPoint(node, type);
     }
+    mDirty = true;
 }
 
 void Edge::resetDestination()
@@ -103,11 +112,13 @@ void Edge::resetDestination()
     if (mTo) {
         mTargetDestination = calculateTargetPoint(mTo, mTargetType);
     }
+    mDirty = true;
 }
 
 void Edge::setTargetPosition(Vector2 position)
 {
     mTargetDestination = position;
+    mDirty             = true;
 }
 
 // Getters
@@ -121,187 +132,200 @@ PolyNode* Edge::getFrom() const
     return mFrom;
 }
 
+int Edge::getWeight() const
+{
+    return mWeight;
+}
+
+int Edge::getType() const
+{
+    return mType;
+}
+
 Vector2 Edge::getDestination() const
 {
     return mDestination;
 }
 
-// Update and draw
-void Edge::update(float dt)
+// Arena bookkeeping
+void Edge::setHandle(EdgeHandle handle)
 {
-    // Smoothly animate destination changes
-    if (Vector2Distance(mDestination, mTargetDestination) > 1.0f) {
-        mDestination.x = Lerp(mDestination.x, mTargetDestination.x, dt * mAnimationSpeed);
-        mDestination.y = Lerp(mDestination.y, mTargetDestination.y, dt * mAnimationSpeed);
-    }
-    else {
-        mDestination = mTargetDestination;
-    }
-
-    // Update destination point if target node moved
-    if (mTo) {
-        mTargetDestination = calculateTargetPoint(mTo, mTargetType);
-    }
+    mHandle = handle;
 }
 
-void Edge::draw()
+EdgeHandle Edge::getHandle() const
 {
-    // Skip drawing if hidden
-    if (mType & EdgeType::Hidden) {
-        return;
-    }
+    return mHandle;
+}
 
-    // Get source position (always from the source node)
-    Vector2 start = {0, 0};
-    if (mFrom) {
-        start = mFrom->getPosition();
-    }
+void Edge::setOutSlot(uint32_t slot)
+{
+    mOutSlot = slot;
+}
 
-    // Draw the appropriate edge type
-    if (mIsCircular) {
-        drawCircularArrow(start, mDestination);
-    }
-    else {
-        drawLine(start, mDestination);
+uint32_t Edge::getOutSlot() const
+{
+    return mOutSlot;
+}
 
-        // Add arrow if directed
-        if (mType & EdgeType::Directed) {
-            drawArrow(start, mDestination);
-        }
-    }
+void Edge::setInSlot(uint32_t slot)
+{
+    mInSlot = slot;
+}
 
-    // Draw weight label if weighted
-    if (mType & EdgeType::Weighted) {
-        drawWeightLabel();
-    }
+uint32_t Edge::getInSlot() const
+{
+    return mInSlot;
+}
 
-    // Draw edge label if it exists
-    if (!mLabel.empty()) {
-        drawPointerLabel();
-    }
+// Change tracking
+void Edge::markDirty()
+{
+    mDirty = true;
 }
 
-// Drawing helper methods
-void Edge::drawLine(Vector2 start, Vector2 end)
+bool Edge::isDirty() const
 {
-    Color lineColor = mHighlighted ? mHighlightColor : mColor;
-    DrawLineEx(start, end, mThickness, lineColor);
+    return mDirty;
 }
 
-void Edge::drawArrow(Vector2 start, Vector2 end)
+const std::string& Edge::getLabel() const
 {
-    // Calculate direction vector
-    float dx     = end.x - start.x;
-    float dy     = end.y - start.y;
-    float length = sqrtf(dx * dx + dy * dy);
+    static const std::string none;
+    return mText ? mText->label.getText() : none;
+}
 
-    // Normalize
-    if (length > 0) {
-        dx /= length;
-        dy /= length;
-    }
+Vector2 Edge::getStart() const
+{
+    return mStart;
+}
 
-    // Calculate perpendicular vectors for arrow
-    float perpX = -dy;
-    float perpY = dx;
+Color Edge::getDrawColor() const
+{
+    return mHighlighted ? mHighlightColor : mColor;
+}
 
-    // Arrow points
-    Vector2 arrowLeft = {
-        end.x - dx * ARROW_SIZE - perpX * ARROW_SIZE * 0.5f,
-        end.y - dy * ARROW_SIZE - perpY * ARROW_SIZE * 0.5f};
+float Edge::getThickness() const
+{
+    return mThickness;
+}
 
-    Vector2 arrowRight = {
-        end.x - dx * ARROW_SIZE + perpX * ARROW_SIZE * 0.5f,
-        end.y - dy * ARROW_SIZE + perpY * ARROW_SIZE * 0.5f};
+void Edge::getArrowHead(Vector2& left, Vector2& right) const
+{
+    left  = mArrowLeft;
+    right = mArrowRight;
+}
 
-    // Draw the arrow
-    Color arrowColor = mHighlighted ? mHighlightColor : mColor;
-    DrawTriangle(end, arrowLeft, arrowRight, arrowColor);
+void Edge::getLoop(Vector2& center, float& radius) const
+{
+    center = {mStart.x + CIRCULAR_OFFSET, mStart.y + CIRCULAR_OFFSET};
+    radius = mFrom ? mFrom->getRadius() * 0.8f : 0.0f;
 }
 
-void Edge::drawCircularArrow(Vector2 start, Vector2 end)
+Rectangle Edge::getBounds() const
 {
-    if (!mFrom)
-        return;
+    Vector2 min = {fminf(mStart.x, mDestination.x), fminf(mStart.y, mDestination.y)};
+    Vector2 max = {fmaxf(mStart.x, mDestination.x), fmaxf(mStart.y, mDestination.y)};
 
-    float radius      = mFrom->getRadius();
-    Color circleColor = mHighlighted ? mHighlightColor : mColor;
+    // Room for the arrow head, or the loop drawn beside the node
+    float margin = ARROW_SIZE + mThickness;
+    if (mIsCircular && mFrom) {
+        margin += fabsf(CIRCULAR_OFFSET) + mFrom->getRadius();
+    }
 
-    // Calculate center position for the circular arrow
-    Vector2 center = {
-        start.x + CIRCULAR_OFFSET,
-        start.y + CIRCULAR_OFFSET};
+    return Rectangle{min.x - margin, min.y - margin, max.x - min.x + margin * 2, max.y - min.y + margin * 2};
+}
 
-    // Draw a semi-circle
-    float startAngle = 0.0f;
-    float endAngle   = 270.0f * DEG2RAD;
-    DrawCircleSectorLines(center, radius * 0.8f, startAngle, endAngle, 20, circleColor);
+// Update and draw
+bool Edge::update(float dt)
+{
+    // Nothing moved and the destination has settled
+    bool settled = mDestination.x == mTargetDestination.x && mDestination.y == mTargetDestination.y;
+    if (!mDirty && settled) {
+        return false;
+    }
 
-    // Draw arrow at the end of the semi-circle
-    Vector2 arrowEnd = {
-        center.x + radius * 0.8f * cosf(endAngle),
-        center.y + radius * 0.8f * sinf(endAngle)};
+    // Update destination point if an endpoint moved
+    if (mDirty && mTo) {
+        mTargetDestination = calculateTargetPoint(mTo, mTargetType);
+    }
+    mDirty = false;
 
-    Vector2 arrowDir = {
-        cosf(endAngle + PI / 4),
-        sinf(endAngle + PI / 4)};
+    // Smoothly animate destination changes
+    if (Vector2Distance(mDestination, mTargetDestination) > 1.0f) {
+        // Never past the target, however long the frame was
+        float amount   = std::min(1.0f, dt * mAnimationSpeed);
+        mDestination.x = Lerp(mDestination.x, mTargetDestination.x, amount);
+        mDestination.y = Lerp(mDestination.y, mTargetDestination.y, amount);
+    }
+    else {
+        mDestination = mTargetDestination;
+    }
 
-    Vector2 arrowPoint1 = {
-        arrowEnd.x + arrowDir.x * ARROW_SIZE,
-        arrowEnd.y + arrowDir.y * ARROW_SIZE};
+    updateGeometry();
+    return true;
+}
 
-    Vector2 arrowPoint2 = {
-        arrowEnd.x + cosf(endAngle - PI / 4) * ARROW_SIZE,
-        arrowEnd.y + sinf(endAngle - PI / 4) * ARROW_SIZE};
+void Edge::drawLabels(RenderQueue& queue) const
+{
+    // Draw weight label if weighted
+    if (mType & EdgeType::Weighted) {
+        drawWeightLabel(queue);
+    }
 
-    DrawTriangle(arrowEnd, arrowPoint1, arrowPoint2, circleColor);
+    // Draw edge label if it exists
+    if (mText && !mText->label.empty()) {
+        drawPointerLabel(queue);
+    }
 }
 
-void Edge::drawWeightLabel()
+void Edge::drawWeightLabel(RenderQueue& queue) const
 {
     if (!mFrom)
         return;
 
-    Vector2 start = mFrom->getPosition();
-
-    // Calculate midpoint for the weight label
-    Vector2 mid = {
-        (start.x + mDestination.x) * 0.5f,
-        (start.y + mDestination.y) * 0.5f};
+    Vector2 mid = mMidpoint;
 
     // Draw weight text
-    std::string weightText = std::to_string(mWeight);
-    Color textColor        = mHighlighted ? mHighlightColor : BLACK;
+    Color textColor = mHighlighted ? mHighlightColor : BLACK;
 
     // Draw with a background for better visibility
-    float fontSize   = 20.0f;
-    Vector2 textSize = MeasureTextEx(GetFontDefault(), weightText.c_str(), fontSize, 1);
-    DrawRectangle(mid.x - textSize.x / 2 - 3, mid.y - textSize.y / 2 - 3,
-                  textSize.x + 6, textSize.y + 6, WHITE);
-    DrawText(weightText.c_str(), mid.x - textSize.x / 2, mid.y - textSize.y / 2, fontSize, textColor);
+    EdgeText& labels = text();
+    if (labels.weightStale) {
+        labels.weight.setText(std::to_string(mWeight));
+        labels.weightStale = false;
+    }
+    Vector2 textSize = labels.weight.getSize();
+    queue.rectangle({mid.x - textSize.x / 2 - 3, mid.y - textSize.y / 2 - 3, textSize.x + 6, textSize.y + 6}, WHITE);
+    labels.weight.draw(queue, {mid.x - textSize.x / 2, mid.y - textSize.y / 2}, textColor);
 }
 
-void Edge::drawPointerLabel()
+void Edge::drawPointerLabel(RenderQueue& queue) const
 {
     if (!mFrom)
         return;
 
-    Vector2 start = mFrom->getPosition();
-
     // Calculate position for the label
     Vector2 labelPos = {
-        (start.x + mDestination.x) * 0.5f + mLabelOffset.x,
-        (start.y + mDestination.y) * 0.5f + mLabelOffset.y};
+        mMidpoint.x + mLabelOffset.x,
+        mMidpoint.y + mLabelOffset.y};
 
     // Draw label text
     Color textColor  = mHighlighted ? mHighlightColor : BLACK;
-    float fontSize   = 18.0f;
-    Vector2 textSize = MeasureTextEx(GetFontDefault(), mLabel.c_str(), fontSize, 1);
+    Vector2 textSize = mText->label.getSize();
 
     // Draw with a background for better visibility
-    DrawRectangle(labelPos.x - textSize.x / 2 - 3, labelPos.y - textSize.y / 2 - 3,
-                  textSize.x + 6, textSize.y + 6, WHITE);
-    DrawText(mLabel.c_str(), labelPos.x - textSize.x / 2, labelPos.y - textSize.y / 2, fontSize, textColor);
+    queue.rectangle({labelPos.x - textSize.x / 2 - 3, labelPos.y - textSize.y / 2 - 3, textSize.x + 6, textSize.y + 6}, WHITE);
+    mText->label.draw(queue, {labelPos.x - textSize.x / 2, labelPos.y - textSize.y / 2}, textColor);
+}
+
+Edge::EdgeText& Edge::text() const
+{
+    if (!mText) {
+        mText.reset(new EdgeText{TextLayout(GetFontDefault(), WEIGHT_FONT_SIZE, 1.0f),
+                                 TextLayout(GetFontDefault(), LABEL_FONT_SIZE, 1.0f), true});
+    }
+    return *mText;
 }
 
 // Calculation helpers
@@ -349,4 +373,61 @@ Vector2 Edge::calculateTargetPoint(PolyNode* node, TargetType type)
     }
 
     return result;
+}
+
+void Edge::updateGeometry()
+{
+    // Get source position (always from the source node)
+    mStart = {0, 0};
+    if (mFrom) {
+        mStart = mFrom->getPosition();
+    }
+
+    mMidpoint = {
+        (mStart.x + mDestination.x) * 0.5f,
+        (mStart.y + mDestination.y) * 0.5f};
+
+    // Self loops end their arc with the arrow, see drawCircularArrow
+    if (mIsCircular) {
+        Vector2 center;
+        float radius;
+        getLoop(center, radius);
+
+        float endAngle   = 270.0f * DEG2RAD;
+        Vector2 arrowEnd = {
+            center.x + radius * cosf(endAngle),
+            center.y + radius * sinf(endAngle)};
+
+        mArrowLeft = {
+            arrowEnd.x + cosf(endAngle + PI / 4) * ARROW_SIZE,
+            arrowEnd.y + sinf(endAngle + PI / 4) * ARROW_SIZE};
+        mArrowRight = {
+            arrowEnd.x + cosf(endAngle - PI / 4) * ARROW_SIZE,
+            arrowEnd.y + sinf(endAngle - PI / 4) * ARROW_SIZE};
+        return;
+    }
+
+    // Calculate direction vector
+    float dx     = mDestination.x - mStart.x;
+    float dy     = mDestination.y - mStart.y;
+    float length = sqrtf(dx * dx + dy * dy);
+
+    // Normalize
+    if (length > 0) {
+        dx /= length;
+        dy /= length;
+    }
+
+    // Calculate perpendicular vectors for arrow
+    float perpX = -dy;
+    float perpY = dx;
+
+    // Arrow points
+    mArrowLeft = {
+        mDestination.x - dx * ARROW_SIZE - perpX * ARROW_SIZE * 0.5f,
+        mDestination.y - dy * ARROW_SIZE - perpY * ARROW_SIZE * 0.5f};
+
+    mArrowRight = {
+        mDestination.x - dx * ARROW_SIZE + perpX * ARROW_SIZE * 0.5f,
+        mDestination.y - dy * ARROW_SIZE + perpY * ARROW_SIZE * 0.5f};
 }
\ No newline at end of file
@@ -0,0 +1,117 @@
+#include "../includes/EdgeArena.hpp"
+
+EdgeHandle EdgeArena::create(PolyNode* from, PolyNode* to, int type)
+{
+    uint32_t slot;
+    if (mFreeSlot != EdgeHandle::INVALID) {
+        // Reuse a released slot
+        slot      = mFreeSlot;
+        mFreeSlot = mSlots[slot].dense;
+    }
+    else if (mSlots.size() <= EdgeHandle::INDEX_MASK) {
+        slot = static_cast<uint32_t>(mSlots.size());
+        mSlots.push_back({0, 0});
+    }
+    else {
+        return EdgeHandle(); // A larger index would alias another slot
+    }
+
+    mSlots[slot].dense = static_cast<uint32_t>(mEdges.size());
+    mEdges.emplace_back(from, to, type);
+    mDenseToSlot.push_back(slot);
+
+    EdgeHandle handle(slot, mSlots[slot].generation);
+    mEdges.back().setHandle(handle);
+    return handle;
+}
+
+void EdgeArena::destroy(EdgeHandle handle)
+{
+    if (!contains(handle)) {
+        return;
+    }
+
+    uint32_t slot  = handle.getIndex();
+    uint32_t dense = mSlots[slot].dense;
+    uint32_t last  = static_cast<uint32_t>(mEdges.size() - 1);
+
+    // Move the last edge into the hole
+    if (dense != last) {
+        mEdges[dense]       = std::move(mEdges[last]);
+        mDenseToSlot[dense] = mDenseToSlot[last];
+
+        mSlots[mDenseToSlot[dense]].dense = dense;
+    }
+    mEdges.pop_back();
+    mDenseToSlot.pop_back();
+
+    // Invalidate outstanding handles and release the slot
+    release(slot);
+}
+
+void EdgeArena::release(uint32_t slot)
+{
+    // A slot whose generation runs out is retired instead of wrapping, so a
+    // stale handle never matches again and no handle can equal INVALID
+    mSlots[slot].generation++;
+    if (mSlots[slot].generation == EdgeHandle::GENERATION_MASK) {
+        return;
+    }
+
+    mSlots[slot].dense = mFreeSlot;
+    mFreeSlot          = slot;
+}
+
+void EdgeArena::clear()
+{
+    // Nothing keeps handles across a clear, so retired slots can start over
+    mFreeSlot = EdgeHandle::INVALID;
+    mSlots.clear();
+    mEdges.clear();
+    mDenseToSlot.clear();
+}
+
+void EdgeArena::reserve(size_t edges)
+{
+    mEdges.reserve(edges);
+    mDenseToSlot.reserve(edges);
+    mSlots.reserve(edges);
+}
+
+Edge* EdgeArena::get(EdgeHandle handle)
+{
+    return contains(handle) ? &mEdges[mSlots[handle.getIndex()].dense] : nullptr;
+}
+
+const Edge* EdgeArena::get(EdgeHandle handle) const
+{
+    return contains(handle) ? &mEdges[mSlots[handle.getIndex()].dense] : nullptr;
+}
+
+Edge* EdgeArena::getBySlot(uint32_t slot)
+{
+    if (slot >= mSlots.size()) {
+        return nullptr;
+    }
+    return get(EdgeHandle(slot, mSlots[slot].generation));
+}
+
+bool EdgeArena::contains(EdgeHandle handle) const
+{
+    if (!handle.isValid() || handle.getIndex() >= mSlots.size()) {
+        return false;
+    }
+
+    const Slot& slot = mSlots[handle.getIndex()];
+    return slot.generation == handle.getGeneration() && slot.dense < mEdges.size() && mDenseToSlot[slot.dense] == handle.getIndex();
+}
+
+int EdgeArena::size() const
+{
+    return static_cast<int>(mEdges.size());
+}
+
+bool EdgeArena::empty() const
+{
+    return mEdges.empty();
+}
@@ -0,0 +1,167 @@
+#include "../includes/EdgeRenderer.hpp"
+#include "../includes/Node.hpp"
+
+EdgeRenderer::EdgeRenderer()
+    : mEdgeCount(0), mLabelCount(0), mVertexCount(0), mImmediateShapeCalls(0)
+{
+}
+
+void EdgeRenderer::begin()
+{
+    for (auto& bucket : mBuckets) {
+        bucket.clear();
+    }
+    mLabelled.clear();
+    mVertices.clear();
+
+    mEdgeCount           = 0;
+    mLabelCount          = 0;
+    mVertexCount         = 0;
+    mImmediateShapeCalls = 0;
+}
+
+void EdgeRenderer::add(const Edge& edge)
+{
+    int type = edge.getType();
+    if (type & EdgeType::Hidden) {
+        return;
+    }
+
+    mBuckets[type & (EdgeType::Directed | EdgeType::Weighted | EdgeType::Circular)].push_back(&edge);
+    mEdgeCount++;
+
+    if ((type & EdgeType::Weighted) || !edge.getLabel().empty()) {
+        mLabelled.push_back(&edge);
+    }
+}
+
+void EdgeRenderer::flush(RenderQueue& queue)
+{
+    // One kernel per type combination, no per-edge type checks
+    writeBucket<0>(mBuckets[0]);
+    writeBucket<EdgeType::Directed>(mBuckets[EdgeType::Directed]);
+    writeBucket<EdgeType::Weighted>(mBuckets[EdgeType::Weighted]);
+    writeBucket<EdgeType::Directed | EdgeType::Weighted>(mBuckets[EdgeType::Directed | EdgeType::Weighted]);
+    writeBucket<EdgeType::Circular>(mBuckets[EdgeType::Circular]);
+    writeBucket<EdgeType::Circular | EdgeType::Directed>(mBuckets[EdgeType::Circular | EdgeType::Directed]);
+    writeBucket<EdgeType::Circular | EdgeType::Weighted>(mBuckets[EdgeType::Circular | EdgeType::Weighted]);
+    writeBucket<EdgeType::Circular | EdgeType::Directed | EdgeType::Weighted>(mBuckets[EdgeType::Circular | EdgeType::Directed | EdgeType::Weighted]);
+
+    submit(queue);
+
+    // Labels go through the font texture, record them after all the geometry
+    for (const Edge* edge : mLabelled) {
+        edge->drawLabels(queue);
+    }
+    mLabelCount = static_cast<int>(mLabelled.size());
+}
+
+// Statistics
+int EdgeRenderer::getEdgeCount() const
+{
+    return mEdgeCount;
+}
+
+int EdgeRenderer::getLabelCount() const
+{
+    return mLabelCount;
+}
+
+int EdgeRenderer::getVertexCount() const
+{
+    return mVertexCount;
+}
+
+int EdgeRenderer::getImmediateShapeCalls() const
+{
+    return mImmediateShapeCalls;
+}
+
+// Kernels
+template <int Type>
+void EdgeRenderer::writeBucket(const std::vector<const Edge*>& edges)
+{
+    for (const Edge* edge : edges) {
+        Color color = edge->getDrawColor();
+
+        if (Type & EdgeType::Circular) {
+            writeLoop(*edge, color);
+            mImmediateShapeCalls += 2;
+        }
+        else {
+            writeLine(edge->getStart(), edge->getDestination(), edge->getThickness(), color);
+            mImmediateShapeCalls++;
+
+            if (Type & EdgeType::Directed) {
+                Vector2 left, right;
+                edge->getArrowHead(left, right);
+                writeTriangle(edge->getDestination(), left, right, color);
+                mImmediateShapeCalls++;
+            }
+        }
+
+        if (Type & EdgeType::Weighted) {
+            mImmediateShapeCalls += 2;
+        }
+    }
+}
+
+void EdgeRenderer::writeLine(Vector2 start, Vector2 end, float thickness, Color color)
+{
+    float dx     = end.x - start.x;
+    float dy     = end.y - start.y;
+    float length = sqrtf(dx * dx + dy * dy);
+    if (length <= 0) {
+        return;
+    }
+
+    // Same quad as DrawLineEx
+    float scale = thickness / (2 * length);
+    dx *= scale;
+    dy *= scale;
+
+    Vector2 strip[4] = {
+        {start.x - dy, start.y + dx},
+        {start.x + dy, start.y - dx},
+        {end.x - dy, end.y + dx},
+        {end.x + dy, end.y - dx}};
+
+    writeTriangle(strip[2], strip[0], strip[1], color);
+    writeTriangle(strip[3], strip[2], strip[1], color);
+}
+
+void EdgeRenderer::writeTriangle(Vector2 a, Vector2 b, Vector2 c, Color color)
+{
+    mVertices.push_back({a.x, a.y, color});
+    mVertices.push_back({b.x, b.y, color});
+    mVertices.push_back({c.x, c.y, color});
+}
+
+void EdgeRenderer::writeLoop(const Edge& edge, Color color)
+{
+    Vector2 center;
+    float radius;
+    edge.getLoop(center, radius);
+
+    // 270 degree arc as thin quads, then the arrow head at its end
+    float endAngle = 270.0f * DEG2RAD;
+    float step     = endAngle / LOOP_SEGMENTS;
+    Vector2 prev   = {center.x + radius, center.y};
+    for (int i = 1; i <= LOOP_SEGMENTS; i++) {
+        Vector2 next = {center.x + radius * cosf(step * i), center.y + radius * sinf(step * i)};
+        writeLine(prev, next, 1.0f, color);
+        prev = next;
+    }
+
+    Vector2 left, right;
+    edge.getArrowHead(left, right);
+    writeTriangle(prev, left, right, color);
+}
+
+void EdgeRenderer::submit(RenderQueue& queue)
+{
+    mVertexCount = static_cast<int>(mVertices.size());
+    if (!mVertices.empty()) {
+        std::copy(mVertices.begin(), mVertices.end(), queue.triangles(static_cast<uint32_t>(mVertices.size())));
+    }
+}
@@ -0,0 +1,434 @@
+#include "../includes/EventTrace.hpp"
+
+namespace {
+    struct TraceHeader {
+        uint32_t magic;
+        uint32_t version;
+        uint64_t steps;
+        uint64_t bytes;
+        uint32_t strings;
+        uint32_t reserved;
+    };
+
+    // Operands following each opcode
+    constexpr int OPERANDS[EventTrace::OpcodeCount] = {0, 2, 3, 2, 2, 2, 3, 0};
+
+    constexpr int MAX_VARINT_BYTES = 10;
+}
+
+// EventTrace implementation
+
+EventTrace::EventTrace()
+    : mSteps(0)
+{
+}
+
+void EventTrace::highlightNode(int node, PolyNode::Highlight type)
+{
+    writeOpcode(HighlightNode);
+    writeVarint(static_cast<uint32_t>(node));
+    writeVarint(static_cast<uint8_t>(type));
+}
+
+void EventTrace::highlightEdge(int from, int to, bool on)
+{
+    writeOpcode(HighlightEdge);
+    writeVarint(static_cast<uint32_t>(from));
+    writeVarint(static_cast<uint32_t>(to));
+    writeVarint(on ? 1 : 0);
+}
+
+void EventTrace::setLabel(int node, const std::string& label)
+{
+    writeOpcode(SetLabel);
+    writeVarint(static_cast<uint32_t>(node));
+    writeVarint(intern(label));
+}
+
+void EventTrace::setData(int node, int64_t value)
+{
+    writeOpcode(SetData);
+    writeVarint(static_cast<uint32_t>(node));
+    writeSigned(value);
+}
+
+void EventTrace::swapData(int a, int b)
+{
+    writeOpcode(SwapData);
+    writeVarint(static_cast<uint32_t>(a));
+    writeVarint(static_cast<uint32_t>(b));
+}
+
+void EventTrace::setEdgeWeight(int from, int to, int weight)
+{
+    writeOpcode(SetEdgeWeight);
+    writeVarint(static_cast<uint32_t>(from));
+    writeVarint(static_cast<uint32_t>(to));
+    writeSigned(weight);
+}
+
+void EventTrace::clearHighlights()
+{
+    writeOpcode(ClearHighlights);
+}
+
+void EventTrace::step()
+{
+    writeOpcode(Step);
+    mSteps++;
+}
+
+void EventTrace::clear()
+{
+    mBytes.clear();
+    mStrings.clear();
+    mStringIds.clear();
+    mSteps = 0;
+}
+
+void EventTrace::reserve(size_t bytes)
+{
+    mBytes.reserve(bytes);
+}
+
+const std::vector<uint8_t>& EventTrace::getBytes() const
+{
+    return mBytes;
+}
+
+const std::string& EventTrace::getString(uint32_t id) const
+{
+    static const std::string empty;
+    return id < mStrings.size() ? mStrings[id] : empty;
+}
+
+size_t EventTrace::getStepCount() const
+{
+    return mSteps;
+}
+
+size_t EventTrace::getByteSize() const
+{
+    size_t size = mBytes.size();
+    for (const auto& text : mStrings) {
+        size += text.size() + 1;
+    }
+    return size;
+}
+
+bool EventTrace::readEvent(size_t& offset, Event& event) const
+{
+    if (offset >= mBytes.size() || mBytes[offset] >= OpcodeCount) {
+        return false;
+    }
+
+    event.op      = static_cast<Opcode>(mBytes[offset++]);
+    uint64_t a[3] = {0, 0, 0};
+    for (int i = 0; i < OPERANDS[event.op]; i++) {
+        if (!readVarint(mBytes, offset, a[i])) {
+            return false;
+        }
+    }
+
+    // Node ids are read back as int
+    auto isNode = [](uint64_t id) { return id <= static_cast<uint64_t>(INT_MAX); };
+    bool valid  = true;
+    switch (event.op) {
+        case HighlightNode:
+            valid = isNode(a[0]) && a[1] <= PolyNode::Highlight::Secondary;
+            break;
+        case HighlightEdge:
+            valid = isNode(a[0]) && isNode(a[1]) && a[2] <= 1;
+            break;
+        case SetLabel:
+            valid = isNode(a[0]) && a[1] < mStrings.size();
+            break;
+        case SetData:
+            valid = isNode(a[0]);
+            a[1]  = static_cast<uint64_t>(unzigzag(a[1]));
+            break;
+        case SwapData:
+            valid = isNode(a[0]) && isNode(a[1]);
+            break;
+        case SetEdgeWeight: {
+            int64_t weight = unzigzag(a[2]);
+            valid          = isNode(a[0]) && isNode(a[1]) && weight >= INT_MIN && weight <= INT_MAX;
+            a[2]           = static_cast<uint64_t>(weight);
+            break;
+        }
+        default:
+            break;
+    }
+
+    for (int i = 0; i < 3; i++) {
+        event.args[i] = static_cast<int64_t>(a[i]);
+    }
+    return valid;
+}
+
+bool EventTrace::readVarint(const std::vector<uint8_t>& bytes, size_t& offset, uint64_t& value)
+{
+    value = 0;
+    for (int i = 0; i < MAX_VARINT_BYTES; i++) {
+        if (offset >= bytes.size()) {
+            return false;
+        }
+        uint8_t byte = bytes[offset++];
+        value |= static_cast<uint64_t>(byte & 0x7F) << (i * 7);
+        if (!(byte & 0x80)) {
+            // The tenth byte only has room for the top bit
+            return i < MAX_VARINT_BYTES - 1 || byte <= 1;
+        }
+    }
+    return false;
+}
+
+int64_t EventTrace::unzigzag(uint64_t value)
+{
+    return static_cast<int64_t>(value >> 1) ^ -static_cast<int64_t>(value & 1);
+}
+
+bool EventTrace::load(const std::string& path)
+{
+    std::ifstream file(path, std::ios::binary);
+    if (!file.is_open()) {
+        return false;
+    }
+
+    TraceHeader header;
+    if (!file.read(reinterpret_cast<char*>(&header), sizeof(header))) {
+        return false;
+    }
+
+    if (header.magic != MAGIC || header.version != VERSION) {
+        return false;
+    }
+
+    // Check the counts before allocating for them: every string takes at
+    // least its terminator, every step one byte of the stream
+    std::error_code error;
+    uintmax_t fileSize = std::filesystem::file_size(path, error);
+    if (error || fileSize < sizeof(header)) {
+        return false;
+    }
+    uint64_t remaining = fileSize - sizeof(header);
+    if (header.bytes > remaining || header.strings > remaining - header.bytes || header.steps > header.bytes) {
+        return false;
+    }
+
+    // Strings are stored zero-terminated, then the event stream
+    EventTrace loaded;
+    loaded.mStrings.resize(header.strings);
+    for (auto& text : loaded.mStrings) {
+        if (!std::getline(file, text, '\0')) {
+            return false;
+        }
+    }
+
+    loaded.mBytes.resize(header.bytes);
+    if (!file.read(reinterpret_cast<char*>(loaded.mBytes.data()), loaded.mBytes.size())) {
+        return false;
+    }
+
+    loaded.mSteps = header.steps;
+    if (!loaded.validate()) {
+        return false;
+    }
+    for (uint32_t i = 0; i < loaded.mStrings.size(); i++) {
+        loaded.mStringIds.emplace(loaded.mStrings[i], i);
+    }
+
+    *this = std::move(loaded);
+    return true;
+}
+
+bool EventTrace::save(const std::string& path) const
+{
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    if (!file.is_open()) {
+        return false;
+    }
+
+    TraceHeader header = {MAGIC, VERSION, mSteps, mBytes.size(), static_cast<uint32_t>(mStrings.size()), 0};
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    for (const auto& text : mStrings) {
+        file.write(text.c_str(), text.size() + 1);
+    }
+    file.write(reinterpret_cast<const char*>(mBytes.data()), mBytes.size());
+
+    return file.good();
+}
+
+// private
+void EventTrace::writeOpcode(Opcode op)
+{
+    mBytes.push_back(op);
+}
+
+void EventTrace::writeVarint(uint64_t value)
+{
+    // LEB128: 7 bits per byte, high bit set while more follow
+    while (value >= 0x80) {
+        mBytes.push_back(static_cast<uint8_t>(value | 0x80));
+        value >>= 7;
+    }
+    mBytes.push_back(static_cast<uint8_t>(value));
+}
+
+void EventTrace::writeSigned(int64_t value)
+{
+    // Zigzag keeps small negative numbers short
+    writeVarint((static_cast<uint64_t>(value) << 1) ^ static_cast<uint64_t>(value >> 63));
+}
+
+bool EventTrace::validate() const
+{
+    // Every event decodes and the step count matches
+    size_t offset = 0;
+    size_t steps  = 0;
+    Event event;
+    while (offset < mBytes.size()) {
+        if (!readEvent(offset, event)) {
+            return false;
+        }
+        if (event.op == Step) {
+            steps++;
+        }
+    }
+    return steps == mSteps;
+}
+
+uint32_t EventTrace::intern(const std::string& text)
+{
+    auto it = mStringIds.find(text);
+    if (it != mStringIds.end()) {
+        return it->second;
+    }
+
+    uint32_t id = static_cast<uint32_t>(mStrings.size());
+    mStrings.push_back(text);
+    mStringIds.emplace(text, id);
+    return id;
+}
+
+// TracePlayer implementation
+// =========================================================
+
+TracePlayer::TracePlayer(const EventTrace& trace, const std::function<PolyNode*(int)>& nodes)
+    : mTrace(&trace), mNodes(nodes), mOffset(0), mStep(0), mFailed(false)
+{
+}
+
+bool TracePlayer::stepForward()
+{
+    size_t size = mTrace->getBytes().size();
+    EventTrace::Event event;
+    while (mOffset < size) {
+        if (!mTrace->readEvent(mOffset, event)) {
+            // Nothing after a broken event can be trusted
+            mOffset = size;
+            mFailed = true;
+            return false;
+        }
+        if (event.op == EventTrace::Step) {
+            mStep++;
+            return true;
+        }
+        execute(event);
+    }
+    return false;
+}
+
+void TracePlayer::advanceTo(size_t step)
+{
+    while (mStep < step && stepForward()) {
+    }
+}
+
+void TracePlayer::reset()
+{
+    mOffset = 0;
+    mStep   = 0;
+    mFailed = false;
+}
+
+size_t TracePlayer::getStep() const
+{
+    return mStep;
+}
+
+bool TracePlayer::isFinished() const
+{
+    return mOffset >= mTrace->getBytes().size();
+}
+
+bool TracePlayer::hasFailed() const
+{
+    return mFailed;
+}
+
+Animation TracePlayer::toAnimation(float stepDuration, const std::function<void()>& restore) const
+{
+    // One copy of the player for every copy of the animation, as they all play on the same scene
+    auto player       = std::make_shared<TracePlayer>(*this);
+    size_t steps      = mTrace->getStepCount();
+    auto playForward  = [player, restore, steps](float progress) {
+        size_t step = static_cast<size_t>(progress * steps);
+        if (step < player->getStep() && restore) {
+            restore();
+            player->reset();
+        }
+        player->advanceTo(step);
+    };
+    auto playBackward = [playForward](float progress) { playForward(1.0f - progress); };
+    return Animation(playForward, playBackward, steps * stepDuration);
+}
+
+// private
+void TracePlayer::execute(const EventTrace::Event& event)
+{
+    const int64_t* args = event.args;
+    auto node           = [&](int i) { return mNodes(static_cast<int>(args[i])); };
+
+    switch (event.op) {
+        case EventTrace::HighlightNode:
+            if (PolyNode* target = node(0)) {
+                target->highlight(static_cast<PolyNode::Highlight>(args[1]));
+            }
+            break;
+        case EventTrace::HighlightEdge:
+            if (PolyNode* from = node(0)) {
+                from->highlightEdge(node(1), args[2] != 0);
+            }
+            break;
+        case EventTrace::SetLabel:
+            if (PolyNode* target = node(0)) {
+                target->setLabel(mTrace->getString(static_cast<uint32_t>(args[1])));
+            }
+            break;
+        case EventTrace::SetData:
+            if (PolyNode* target = node(0)) {
+                target->setData(args[1]);
+            }
+            break;
+        case EventTrace::SwapData:
+            if (PolyNode* a = node(0)) {
+                a->swapData(node(1));
+            }
+            break;
+        case EventTrace::SetEdgeWeight:
+            if (PolyNode* from = node(0)) {
+                from->setEdgeWeight(node(1), static_cast<int>(args[2]));
+            }
+            break;
+        case EventTrace::ClearHighlights:
+            // Every node the resolver knows, until it runs out
+            for (int id = 0; PolyNode* target = mNodes(id); id++) {
+                target->highlight(PolyNode::Highlight::None);
+                target->clearEdgeHighlights();
+            }
+            break;
+        default:
+            break;
+    }
+}
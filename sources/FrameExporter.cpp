@@ -0,0 +1,155 @@
+#include "../includes/FrameExporter.hpp"
+
+namespace {
+    struct SceneName {
+        const char* name;
+        Scene scene;
+    };
+
+    const SceneName SCENE_NAMES[] = {
+        {"title", Scene::TITLE},
+        {"menu", Scene::MENU},
+        {"hashtable", Scene::HASHTABLE},
+        {"linkedlist", Scene::LINKEDLIST},
+        {"avltree", Scene::AVLTREE},
+        {"graph", Scene::GRAPH},
+    };
+}
+
+FrameExporter::FrameExporter(const std::string& directory, const std::string& format, int workers)
+    : mDirectory(directory),
+      mFormat(format),
+      mMaxPending(0),
+      mStopping(false),
+      mWritten(0),
+      mFailed(false)
+{
+    std::error_code error;
+    std::filesystem::create_directories(mDirectory, error);
+
+    if (workers <= 0) {
+        workers = std::max(1, static_cast<int>(std::thread::hardware_concurrency()));
+    }
+    mMaxPending = static_cast<size_t>(workers * PENDING_PER_WORKER);
+
+    for (int i = 0; i < workers; i++) {
+        mWorkers.emplace_back(&FrameExporter::work, this);
+    }
+}
+
+FrameExporter::~FrameExporter()
+{
+    finish();
+}
+
+bool FrameExporter::parseArguments(int argc, char* argv[], ExportOptions& options)
+{
+    bool found = false;
+    for (int i = 1; i < argc; i++) {
+        std::string argument = argv[i];
+        bool exporting       = argument == EXPORT_ARGUMENT && i + 3 < argc;
+        bool counting        = argument == COUNT_ARGUMENT && i + 2 < argc;
+
+        if (exporting || counting) {
+            std::string name = argv[i + 1];
+            auto it          = std::find_if(std::begin(SCENE_NAMES), std::end(SCENE_NAMES),
+                                            [&](const SceneName& scene) { return name == scene.name; });
+            if (it == std::end(SCENE_NAMES)) {
+                return false;
+            }
+
+            options.scene  = it->scene;
+            options.frames = std::atoi(argv[i + 2]);
+            options.count  = counting;
+            found          = options.frames > 0;
+            if (exporting) {
+                options.directory = argv[i + 3];
+                i++;
+            }
+            i += 2;
+        }
+        else if (argument == "--format" && i + 1 < argc) {
+            options.format = argv[++i];
+        }
+        else if (argument == "--fps" && i + 1 < argc) {
+            options.fps = std::max(1.0f, static_cast<float>(std::atof(argv[++i])));
+        }
+        else if (argument == "--workers" && i + 1 < argc) {
+            options.workers = std::atoi(argv[++i]);
+        }
+    }
+
+    return found && (options.format == "png" || options.format == "qoi");
+}
+
+void FrameExporter::submit(Image image, int frame)
+{
+    std::unique_lock<std::mutex> lock(mMutex);
+    // Bounded queue, rendering may not run away from the encoders
+    mHasRoom.wait(lock, [this]() { return mJobs.size() < mMaxPending; });
+    mJobs.push({image, frame});
+    mHasJob.notify_one();
+}
+
+bool FrameExporter::finish()
+{
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        mStopping = true;
+    }
+    mHasJob.notify_all();
+
+    for (auto& worker : mWorkers) {
+        if (worker.joinable()) {
+            worker.join();
+        }
+    }
+    mWorkers.clear();
+
+    return !mFailed;
+}
+
+int FrameExporter::getWorkerCount() const
+{
+    return static_cast<int>(mWorkers.size());
+}
+
+int FrameExporter::getWrittenCount() const
+{
+    return mWritten;
+}
+
+// private
+void FrameExporter::work()
+{
+    while (true) {
+        Job job;
+        {
+            std::unique_lock<std::mutex> lock(mMutex);
+            mHasJob.wait(lock, [this]() { return mStopping || !mJobs.empty(); });
+            if (mJobs.empty()) {
+                return; // Stopping and drained
+            }
+            job = mJobs.front();
+            mJobs.pop();
+        }
+        mHasRoom.notify_one();
+
+        // CPU only from here, no GL calls off the main thread
+        ImageFlipVertical(&job.image);
+        if (ExportImage(job.image, framePath(job.frame).c_str())) {
+            mWritten++;
+        }
+        else {
+            mFailed = true;
+        }
+        UnloadImage(job.image);
+    }
+}
+
+std::string FrameExporter::framePath(int frame) const
+{
+    char name[32];
+    std::snprintf(name, sizeof(name), "frame_%06d.%s", frame, mFormat.c_str());
+    return (std::filesystem::path(mDirectory) / name).string();
+}
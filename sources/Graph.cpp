@@ -8,10 +8,17 @@ Graph::Graph()
       mTime(0),
       mIsDirected(true),
       mIsWeighted(false),
+      mRandom(RandomService::stream(Scene::GRAPH)),
+      mLayoutFingerprint(0),
+      mLayoutSaved(false),
+      mNodeGrid(GRID_CELL_SIZE),
+      mEdgeGrid(GRID_CELL_SIZE),
+      mDrawnNodes(0),
+      mDrawnEdges(0),
+      mDragNode(-1),
+      mDragOffset({0, 0}),
       camera(nullptr)
 {
-    // Seed the random number generator
-    SetRandomSeed(static_cast<unsigned int>(time(nullptr)));
 }
 
 void Graph::init()
@@ -53,17 +60,19 @@ void Graph::init()
             if (newNodeIndex < MAX_SIZE) {
                 // First build a new node
                 Font defaultFont = GetFontDefault();
-                auto node        = std::make_unique<GraphNode>(defaultFont);
-                node->setData(std::to_string(newNodeIndex));
+                auto node        = std::make_unique<GraphNode>(defaultFont, mEdgeArena);
+                node->setData(newNodeIndex);
+                node->setId(newNodeIndex);
 
                 // Position it near the center with a small random offset
                 Vector2 center = {GetScreenWidth() / 2.0f, GetScreenHeight() / 2.0f};
-                float offsetX  = static_cast<float>(GetRandomValue(-GetScreenWidth() / 4, GetScreenWidth() / 4));
-                float offsetY  = static_cast<float>(GetRandomValue(-GetScreenHeight() / 4, GetScreenHeight() / 4));
+                float offsetX  = static_cast<float>(mRandom.nextInt(-GetScreenWidth() / 4, GetScreenWidth() / 4));
+                float offsetY  = static_cast<float>(mRandom.nextInt(-GetScreenHeight() / 4, GetScreenHeight() / 4));
                 node->setPosition(center.x + offsetX, center.y + offsetY);
 
                 // Add the node to the graph
                 mNodes.push_back(std::move(node));
+                updateNodeGrid(newNodeIndex);
 
                 // Reset layout process to reposition nodes
                 arrangeNodes();
@@ -86,19 +95,7 @@ void Graph::init()
         [this]() {
             // Remove the last node if we have any
             if (!mNodes.empty()) {
-                // First, remove all edges connected to this node
-                int nodeToRemove = getNumNodes() - 1;
-
-                // Remove all edges that involve this node
-                mEdges.erase(
-                    std::remove_if(mEdges.begin(), mEdges.end(),
-                                   [nodeToRemove](const EdgeTuple& edge) {
-                                       return edge.from == nodeToRemove || edge.to == nodeToRemove;
-                                   }),
-                    mEdges.end());
-
-                // Remove the node
-                mNodes.pop_back();
+                removeNode(getNumNodes() - 1);
 
                 // Reset layout process
                 arrangeNodes();
@@ -123,16 +120,16 @@ void Graph::init()
             int numNodes = getNumNodes();
             if (numNodes >= 2) {
                 // Get two random nodes to connect
-                int from = GetRandomValue(0, numNodes - 1);
-                int to   = GetRandomValue(0, numNodes - 1);
+                int from = mRandom.nextInt(0, numNodes - 1);
+                int to   = mRandom.nextInt(0, numNodes - 1);
 
                 // Make sure they're different nodes
                 while (from == to) {
-                    to = GetRandomValue(0, numNodes - 1);
+                    to = mRandom.nextInt(0, numNodes - 1);
                 }
 
                 // Add edge between the nodes
-                int weight = mIsWeighted ? GetRandomValue(1, MAX_WEIGHT) : 1;
+                int weight = mIsWeighted ? mRandom.nextInt(1, MAX_WEIGHT) : 1;
                 addEdge(from, to, weight);
             }
         },
@@ -142,14 +139,30 @@ void Graph::init()
         BLACK      // text color
     );
 
+    // Breadth-first search button
+    auto bfsBtn = std::make_unique<ActionButton>(
+        Rectangle{static_cast<float>(GetScreenWidth() - buttonWidth * 4 - padding * 4),
+                  static_cast<float>(buttonY),
+                  static_cast<float>(buttonWidth),
+                  static_cast<float>(buttonHeight)},
+        "BFS",
+        baseFontSize,
+        [this]() { playBFS(0); },
+        LIGHTGRAY, // normal color
+        GRAY,      // hover color
+        DARKGRAY,  // click color
+        BLACK      // text color
+    );
+
     buttons.push_back(std::move(addNodeBtn));
     buttons.push_back(std::move(removeNodeBtn));
     buttons.push_back(std::move(addEdgeBtn));
+    buttons.push_back(std::move(bfsBtn));
 }
 
 void Graph::update()
 {
-    float dt = GetFrameTime();
+    float dt = Application::getInstance()->getFrameDelta();
 
     updateComponents();
 
@@ -170,39 +183,108 @@ void Graph::update()
         button->update();
     }
 
-    // Force-directed layout update
+    // Mouse interaction, after the layout ticks so a dragged node stays put
+    handleNodeDragging();
+
+    if (mAnimations.isPlaying()) {
+        mAnimations.update(dt);
+        markDirty();
+    }
+
+    // Draw nodes between the last two ticks and keep the spatial index on them
+    float alpha = Application::getInstance()->getAlpha();
+    bool moved  = false;
+    for (int i = 0; i < getNumNodes(); i++) {
+        if (mNodes[i]->interpolate(alpha) || mNodes[i]->isResizing())
+            moved = true;
+        updateNodeGrid(i);
+    }
+
+    // Update edges, only the ones that moved are re-indexed
+    for (Edge& edge : mEdgeArena) {
+        if (edge.update(dt)) {
+            mEdgeGrid.update(edge.getHandle().getIndex(), edge.getBounds());
+            moved = true;
+        }
+    }
+
+    // A settled layout leaves the last frame on screen
+    if (moved)
+        markDirty();
+}
+
+void Graph::fixedUpdate(float dt)
+{
+    // Force-directed layout, one iteration per tick
     rearrange();
 
-    // Update nodes
     for (auto& node : mNodes) {
         node->update(dt);
     }
 }
 
+void Graph::loadDemo()
+{
+    randomize(MAX_SIZE, MAX_SIZE * 2);
+}
+
+bool Graph::isAnimating() const
+{
+    return mAnimations.isPlaying();
+}
+
 void Graph::draw()
 {
-    // Begin camera mode for graph rendering
-    camera->beginMode();
-    // First, draw all edges
-    for (auto& node : mNodes) {
-        // We need to iterate through each node's outgoing edges
-        for (const auto& edge : node->getOutEdges()) {
-            // Update and draw the edge
-            edge->update(GetFrameTime());
-            edge->draw();
-        }
+    // Everything is recorded in world space, under the camera
+    RenderQueue& queue = Application::getInstance()->getRenderQueue();
+    queue.beginWorld(camera->getCamera());
+    // Only draw what intersects the visible part of the world
+    Rectangle view = camera->getWorldRect();
+    view           = {view.x - CULL_MARGIN, view.y - CULL_MARGIN, view.width + CULL_MARGIN * 2, view.height + CULL_MARGIN * 2};
+
+    // First, all visible edges with their labels, under the nodes
+    queue.setLayer(RenderQueue::LAYER_BACKGROUND);
+    mVisible.clear();
+    mEdgeGrid.queryRect(view, mVisible);
+    mEdgeRenderer.begin();
+    for (int slot : mVisible) {
+        mEdgeRenderer.add(*mEdgeArena.getBySlot(static_cast<uint32_t>(slot)));
     }
-
-    // Draw graph elements
-    for (auto& node : mNodes) {
-        node->draw();
+    mEdgeRenderer.flush(queue);
+    mDrawnEdges = mEdgeRenderer.getEdgeCount();
+
+    // Draw graph elements, nodes in id order so overlaps stay stable
+    queue.setLayer(RenderQueue::LAYER_SHAPES);
+    mVisible.clear();
+    mNodeGrid.queryRect(view, mVisible);
+    std::sort(mVisible.begin(), mVisible.end());
+    mNodeRenderer.begin(camera->getZoom());
+    for (int id : mVisible) {
+        mNodeRenderer.add(*mNodes[id]);
     }
-    camera->endMode();
-    // Draw other information
-    std::string infoText = TextFormat("Nodes: %d, Edges: %d", getNumNodes(), getNumEdges());
-    DrawText(infoText.c_str(), 10, GetScreenHeight() - 30, 20, BLACK);
+    mNodeRenderer.flush(queue);
+    mDrawnNodes = mNodeRenderer.getNodeCount();
 
-    DrawText("This is Graph", 300, 300, 20, BLACK);
+    queue.setLayer(RenderQueue::LAYER_TEXT);
+    for (int id : mVisible) {
+        mNodes[id]->drawLabels(queue);
+    }
+    queue.endWorld();
+
+    // Draw other information, the queue's numbers are from the previous frame
+    std::string infoText = TextFormat("Nodes: %d/%d, Edges: %d/%d drawn",
+                                      mDrawnNodes, getNumNodes(), mDrawnEdges, getNumEdges());
+    queue.text(infoText.c_str(), 10, GetScreenHeight() - 30, 20, BLACK);
+    queue.text(TextFormat("Edge vertices: %d, labels: %d (per-edge: %d raylib calls)",
+                          mEdgeRenderer.getVertexCount(), mEdgeRenderer.getLabelCount(), mEdgeRenderer.getImmediateShapeCalls()),
+               10, GetScreenHeight() - 55, 20, BLACK);
+    queue.text(TextFormat("Node vertices: %d", mNodeRenderer.getVertexCount()),
+               10, GetScreenHeight() - 80, 20, BLACK);
+    queue.text(TextFormat("Queued commands: %d, batches: %d (recorded order %d)",
+                          queue.getCommandCount(), queue.getBatchCount(), queue.getUnsortedBatchCount()),
+               10, GetScreenHeight() - 105, 20, BLACK);
+
+    queue.text("This is Graph", 300, 300, 20, BLACK);
 
     for (auto& button : buttons) {
         button->draw();
@@ -212,6 +294,7 @@ void Graph::draw()
 
 void Graph::clean()
 {
+    saveLayout();
     clear();
     buttons.clear();
     cleanComponents();
@@ -219,9 +302,18 @@ void Graph::clean()
 
 void Graph::clear()
 {
+    mAnimations.clear();
+    mTrace.clear();
     mNodes.clear();
-    mEdges.clear();
-    mTime = 0;
+    mEdgeIndex.clear();
+    mEdgeArena.clear();
+    mNodeGrid.clear();
+    mEdgeGrid.clear();
+    mDragNode = -1;
+    mTime     = 0;
+    mLayoutPath.clear();
+    mLayoutFingerprint = 0;
+    mLayoutSaved       = false;
 }
 
 void Graph::clearHighlight()
@@ -232,6 +324,79 @@ void Graph::clearHighlight()
     }
 }
 
+void Graph::recordBFS(int start, EventTrace& trace) const
+{
+    trace.clear();
+    if (start < 0 || start >= getNumNodes()) {
+        return;
+    }
+
+    // Secondary marks queued nodes, Primary the one being expanded
+    std::vector<bool> visited(getNumNodes(), false);
+    std::deque<int> queue = {start};
+    int order             = 0;
+    visited[start]        = true;
+    trace.highlightNode(start, PolyNode::Highlight::Secondary);
+    trace.setLabel(start, std::to_string(order++));
+    trace.step();
+
+    while (!queue.empty()) {
+        int id = queue.front();
+        queue.pop_front();
+        trace.highlightNode(id, PolyNode::Highlight::Primary);
+        trace.step();
+
+        auto visit = [&](EdgeHandle handle) {
+            const Edge* edge = mEdgeArena.get(handle);
+            int from         = nodeId(edge->getFrom());
+            int to           = nodeId(edge->getTo());
+            int next         = from == id ? to : from;
+            if (visited[next]) {
+                return;
+            }
+
+            visited[next] = true;
+            queue.push_back(next);
+            trace.highlightEdge(from, to);
+            trace.highlightNode(next, PolyNode::Highlight::Secondary);
+            trace.setLabel(next, std::to_string(order++));
+            trace.step();
+        };
+
+        for (EdgeHandle handle : mNodes[id]->getOutEdges()) {
+            visit(handle);
+        }
+        // Undirected graphs store each edge once, in either direction
+        if (!mIsDirected) {
+            for (EdgeHandle handle : mNodes[id]->getInEdges()) {
+                visit(handle);
+            }
+        }
+    }
+}
+
+void Graph::playBFS(int start)
+{
+    mAnimations.clear();
+    recordBFS(start, mTrace);
+    if (mTrace.getStepCount() == 0) {
+        return;
+    }
+
+    // The state every recorded trace starts from
+    auto restore = [this]() {
+        clearHighlight();
+        for (auto& node : mNodes) {
+            node->setLabel("");
+        }
+    };
+    restore();
+
+    TracePlayer player(mTrace, [this](int id) { return getNode(id); });
+    mAnimations.push(player.toAnimation(TRACE_STEP, restore));
+    mAnimations.play();
+}
+
 void Graph::loadFromFile(const std::string& fileDir)
 {
     std::ifstream file(fileDir);
@@ -260,7 +425,13 @@ void Graph::loadFromFile(const std::string& fileDir)
     }
 
     file.close();
-    arrangeNodes();
+
+    // Reuse the positions of a previous session if there is one
+    mLayoutPath        = LayoutCache::sidecarPath(fileDir);
+    mLayoutFingerprint = LayoutCache::fingerprint(getNumNodes(), layoutEdges());
+    if (!restoreLayout()) {
+        arrangeNodes();
+    }
 }
 
 void Graph::randomize(int nodes, int edges)
@@ -275,7 +446,7 @@ void Graph::randomize(int nodes, int edges)
     for (int i = 0; i < nodes; i++) {
         for (int j = 0; j < nodes; j++) {
             if (i != j) {
-                int weight = GetRandomValue(1, MAX_WEIGHT);
+                int weight = mRandom.nextInt(1, MAX_WEIGHT);
                 allPossibleEdges.emplace_back(i, j, weight);
             }
         }
@@ -286,7 +457,7 @@ void Graph::randomize(int nodes, int edges)
 
     // Shuffle algorithm
     for (size_t i = 0; i < allPossibleEdges.size() - 1; i++) {
-        size_t j = i + GetRandomValue(0, static_cast<int>(allPossibleEdges.size() - i - 1));
+        size_t j = i + mRandom.nextInt(0, static_cast<int>(allPossibleEdges.size() - i - 1));
         std::swap(allPossibleEdges[i], allPossibleEdges[j]);
     }
 
@@ -307,10 +478,11 @@ void Graph::build(int nodes)
     Font defaultFont = GetFontDefault();
 
     for (int i = 0; i < nodes; i++) {
-        auto node = std::make_unique<GraphNode>(defaultFont);
+        auto node = std::make_unique<GraphNode>(defaultFont, mEdgeArena);
 
         // Set node data
-        node->setData(std::to_string(i));
+        node->setId(static_cast<int>(mNodes.size()));
+        node->setData(i);
 
         // Circular layout initially
         float angle = (float)i / nodes * 2 * PI;
@@ -319,6 +491,7 @@ void Graph::build(int nodes)
         node->setPosition(x, y);
 
         mNodes.push_back(std::move(node));
+        updateNodeGrid(getNumNodes() - 1);
     }
 }
 
@@ -329,57 +502,28 @@ void Graph::addEdge(int from, int to, int weight)
         return;
     }
 
-    // Check if edge already exists
-    auto edgeIt = std::find_if(mEdges.begin(), mEdges.end(),
-                               [from, to](const EdgeTuple& edge) {
-                                   return edge.from == from && edge.to == to;
-                               });
-
-    if (edgeIt != mEdges.end()) {
+    // Check if edge already exists, in either direction for undirected graphs
+    Edge* existing = mEdgeArena.get(findEdge(from, to));
+    if (existing) {
         // Update weight if edge exists
-        edgeIt->weight = weight;
-
-        // Update visual edge weight
-        if (mIsWeighted) {
-            mNodes[from]->setEdgeWeight(mNodes[to].get(), weight);
-        }
+        existing->setWeight(weight);
         return;
     }
 
-    // Add new edge
-    mEdges.emplace_back(from, to, weight);
-
-    // Create visual connection
-    mNodes[from]->makeAdjacent(mNodes[to].get());
-
-    // Set edge properties
+    // Add new edge, undirected graphs keep a single edge per pair
     int edgeType = mIsDirected ? EdgeType::Directed : 0;
     if (mIsWeighted) {
         edgeType |= EdgeType::Weighted;
-        mNodes[from]->setEdgeWeight(mNodes[to].get(), weight);
     }
 
-    mNodes[from]->setEdgeType(mNodes[to].get(), edgeType);
-
-    // If undirected, add reverse edge too
-    if (!mIsDirected) {
-        // Only add if it doesn't exist
-        auto reverseEdgeIt = std::find_if(mEdges.begin(), mEdges.end(),
-                                          [from, to](const EdgeTuple& edge) {
-                                              return edge.from == to && edge.to == from;
-                                          });
-
-        if (reverseEdgeIt == mEdges.end()) {
-            mEdges.emplace_back(to, from, weight);
-            mNodes[to]->makeAdjacent(mNodes[from].get());
-
-            if (mIsWeighted) {
-                mNodes[to]->setEdgeWeight(mNodes[from].get(), weight);
-            }
-
-            mNodes[to]->setEdgeType(mNodes[from].get(), edgeType);
-        }
+    size_t outDegree = mNodes[from]->getOutEdges().size();
+    mNodes[from]->addEdgeOut(mNodes[to].get(), edgeType);
+    if (mNodes[from]->getOutEdges().size() == outDegree) {
+        return; // The arena is full
     }
+    EdgeHandle handle = mNodes[from]->getOutEdges().back();
+    mEdgeArena.get(handle)->setWeight(weight);
+    mEdgeIndex[edgeKey(from, to)] = handle;
 }
 
 void Graph::removeEdge(int from, int to)
@@ -389,33 +533,65 @@ void Graph::removeEdge(int from, int to)
         return;
     }
 
-    // Find and remove the edge from the list
-    auto edgeIt = std::find_if(mEdges.begin(), mEdges.end(),
-                               [from, to](const EdgeTuple& edge) {
-                                   return edge.from == from && edge.to == to;
-                               });
+    // Undirected graphs may hold both directions after a direction change
+    EdgeHandle handle;
+    while ((handle = findEdge(from, to)).isValid()) {
+        removeEdge(handle);
+    }
+}
 
-    if (edgeIt != mEdges.end()) {
-        mEdges.erase(edgeIt);
+void Graph::removeNode(int id)
+{
+    // Validate index
+    if (id < 0 || id >= getNumNodes()) {
+        return;
+    }
 
-        // Remove the visual connection
-        mNodes[from]->removeEdgeOut(mNodes[to].get());
+    // Remove the edges of the node
+    GraphNode* node = mNodes[id].get();
+    while (!node->getOutEdges().empty()) {
+        removeEdge(node->getOutEdges().back());
+    }
+    while (!node->getInEdges().empty()) {
+        removeEdge(node->getInEdges().back());
     }
 
-    // If undirected, remove the reverse edge too
-    if (!mIsDirected) {
-        auto reverseEdgeIt = std::find_if(mEdges.begin(), mEdges.end(),
-                                          [from, to](const EdgeTuple& edge) {
-                                              return edge.from == to && edge.to == from;
-                                          });
+    // Move the last node into the hole and re-key only its edges
+    int last = getNumNodes() - 1;
+    if (id != last) {
+        GraphNode* moved = mNodes[last].get();
+        for (EdgeHandle handle : moved->getOutEdges()) {
+            mEdgeIndex.erase(edgeKey(last, nodeId(mEdgeArena.get(handle)->getTo())));
+        }
+        for (EdgeHandle handle : moved->getInEdges()) {
+            mEdgeIndex.erase(edgeKey(nodeId(mEdgeArena.get(handle)->getFrom()), last));
+        }
 
-        if (reverseEdgeIt != mEdges.end()) {
-            mEdges.erase(reverseEdgeIt);
+        std::swap(mNodes[id], mNodes[last]);
+        moved->setId(id);
+        moved->setData(id);
 
-            // Remove the visual connection
-            mNodes[to]->removeEdgeOut(mNodes[from].get());
+        for (EdgeHandle handle : moved->getOutEdges()) {
+            mEdgeIndex[edgeKey(id, nodeId(mEdgeArena.get(handle)->getTo()))] = handle;
+        }
+        for (EdgeHandle handle : moved->getInEdges()) {
+            mEdgeIndex[edgeKey(nodeId(mEdgeArena.get(handle)->getFrom()), id)] = handle;
         }
     }
+
+    // Keep the interaction state pointing at the same nodes
+    if (mDragNode == id) {
+        mDragNode = -1;
+    }
+    else if (mDragNode == last) {
+        mDragNode = id;
+    }
+
+    mNodes.pop_back();
+    mNodeGrid.remove(last);
+    if (id != last) {
+        updateNodeGrid(id);
+    }
 }
 
 void Graph::setDirected(bool isDirected)
@@ -423,19 +599,9 @@ void Graph::setDirected(bool isDirected)
     if (mIsDirected == isDirected)
         return;
 
+    // Direction is only a view over the same edges, nodes keep their positions
     mIsDirected = isDirected;
-
-    // Recreate edges with new direction setting
-    std::vector<EdgeTuple> oldEdges = mEdges;
-    clear();
-
-    // Rebuild nodes
-    build(oldEdges.empty() ? 0 : getNumNodes());
-
-    // Rebuild edges
-    for (const auto& edge : oldEdges) {
-        addEdge(edge.from, edge.to, edge.weight);
-    }
+    applyEdgeTypes();
 }
 
 void Graph::setWeighted(bool isWeighted)
@@ -444,20 +610,42 @@ void Graph::setWeighted(bool isWeighted)
         return;
 
     mIsWeighted = isWeighted;
+    applyEdgeTypes();
+}
+
+void Graph::applyEdgeTypes()
+{
+    int edgeType = mIsDirected ? EdgeType::Directed : 0;
+    if (mIsWeighted) {
+        edgeType |= EdgeType::Weighted;
+    }
 
-    // Update edge type for all edges
-    for (auto& edge : mEdges) {
-        int from = edge.from;
-        int to   = edge.to;
+    for (Edge& edge : mEdgeArena) {
+        int type = edgeType;
 
-        int edgeType = mIsDirected ? EdgeType::Directed : 0;
-        if (mIsWeighted) {
-            edgeType |= EdgeType::Weighted;
-            mNodes[from]->setEdgeWeight(mNodes[to].get(), edge.weight);
+        // An undirected view draws a two-way pair once
+        if (!mIsDirected) {
+            int from = nodeId(edge.getFrom());
+            int to   = nodeId(edge.getTo());
+            if (from > to && mEdgeIndex.count(edgeKey(to, from))) {
+                type |= EdgeType::Hidden;
+            }
         }
 
-        mNodes[from]->setEdgeType(mNodes[to].get(), edgeType);
+        edge.setType(type);
+    }
+}
+
+std::vector<Graph::EdgeTuple> Graph::getEdges() const
+{
+    std::vector<EdgeTuple> edges;
+    edges.reserve(mEdgeArena.size());
+
+    for (const Edge& edge : mEdgeArena) {
+        edges.emplace_back(nodeId(edge.getFrom()), nodeId(edge.getTo()), edge.getWeight());
     }
+
+    return edges;
 }
 
 void Graph::rearrange()
@@ -503,29 +691,231 @@ void Graph::rearrange()
     if (mMaxForce < FORCE_EPSILON) {
         mTime = UPDATE_LOOPS;
     }
+
+    // Remember the converged layout
+    if (mTime >= UPDATE_LOOPS) {
+        saveLayout();
+    }
 }
 
 void Graph::arrangeNodes()
 {
     // Reset the layout process
-    mTime     = 0;
-    mCoolDown = COOL_DOWN;
+    mTime        = 0;
+    mCoolDown    = COOL_DOWN;
+    mLayoutSaved = false;
 
     // Give nodes some initial velocity to help them spread out
     for (auto& node : mNodes) {
         Vector2 randomVel = {
-            static_cast<float>(GetRandomValue(-50, 50)),
-            static_cast<float>(GetRandomValue(-50, 50))};
+            static_cast<float>(mRandom.nextInt(-50, 50)),
+            static_cast<float>(mRandom.nextInt(-50, 50))};
         node->setVelocity(randomVel);
     }
 }
 
+LayoutCache::EdgeList Graph::layoutEdges() const
+{
+    // Undirected edges are keyed by their smaller endpoint first
+    LayoutCache::EdgeList edges;
+    edges.reserve(mEdgeArena.size());
+    for (const Edge& edge : mEdgeArena) {
+        int from = nodeId(edge.getFrom());
+        int to   = nodeId(edge.getTo());
+        if (!mIsDirected && from > to) {
+            std::swap(from, to);
+        }
+        edges.emplace_back(from, to);
+    }
+    std::sort(edges.begin(), edges.end());
+    edges.erase(std::unique(edges.begin(), edges.end()), edges.end());
+
+    return edges;
+}
+
+bool Graph::restoreLayout()
+{
+    LayoutCache cache;
+    if (mLayoutPath.empty() || !cache.load(mLayoutPath, LayoutCache::maxNearNodes(getNumNodes()))) {
+        return false;
+    }
+
+    // A layout of a different graph would only get in the way
+    LayoutCache::EdgeList edges = layoutEdges();
+    bool exact                  = cache.matches(mLayoutFingerprint, getNumNodes());
+    if (!exact && !cache.isNear(getNumNodes(), edges)) {
+        return false;
+    }
+
+    const std::vector<Vector2>& positions = cache.getPositions();
+    int known = std::min(getNumNodes(), cache.getNumNodes());
+    for (int i = 0; i < known; i++) {
+        mNodes[i]->setPosition(positions[i]);
+        mNodes[i]->setVelocity({0, 0});
+    }
+
+    if (exact) {
+        // Same graph, it is already converged
+        mTime        = UPDATE_LOOPS;
+        mLayoutSaved = true;
+    }
+    else {
+        // Near match, resume the layout from the old positions with less energy
+        mTime        = 0;
+        mCoolDown    = WARM_COOL_DOWN;
+        mLayoutSaved = false;
+    }
+
+    return true;
+}
+
+void Graph::saveLayout()
+{
+    if (mLayoutPath.empty() || mLayoutSaved || mNodes.empty()) {
+        return;
+    }
+
+    // The sidecar belongs to the file, an edited graph keeps it as it is
+    LayoutCache::EdgeList edges = layoutEdges();
+    if (LayoutCache::fingerprint(getNumNodes(), edges) != mLayoutFingerprint) {
+        return;
+    }
+
+    std::vector<Vector2> positions;
+    positions.reserve(mNodes.size());
+    for (const auto& node : mNodes) {
+        positions.push_back(node->getSimulatedPosition());
+    }
+
+    LayoutCache cache;
+    cache.setLayout(mLayoutFingerprint, positions, edges);
+    mLayoutSaved = cache.save(mLayoutPath);
+}
+
 int Graph::getNumNodes() const
 {
     return static_cast<int>(mNodes.size());
 }
 
+PolyNode* Graph::getNode(int id)
+{
+    if (id < 0 || id >= getNumNodes()) {
+        return nullptr;
+    }
+    return mNodes[id].get();
+}
+
 int Graph::getNumEdges() const
 {
-    return static_cast<int>(mEdges.size());
+    return mEdgeArena.size();
+}
+
+int Graph::getDrawnNodes() const
+{
+    return mDrawnNodes;
+}
+
+int Graph::getDrawnEdges() const
+{
+    return mDrawnEdges;
+}
+
+int Graph::pickNode(Vector2 position) const
+{
+    std::vector<int> candidates;
+    mNodeGrid.queryPoint(position, candidates);
+
+    // Closest node whose circle contains the position
+    int picked       = -1;
+    float pickedDist = 0;
+    for (int id : candidates) {
+        const GraphNode& node = *mNodes[id];
+        float distance        = Vector2Distance(position, node.getPosition());
+        if (distance <= node.getRadius() && (picked == -1 || distance < pickedDist)) {
+            picked     = id;
+            pickedDist = distance;
+        }
+    }
+
+    return picked;
+}
+
+void Graph::updateNodeGrid(int id)
+{
+    const GraphNode& node = *mNodes[id];
+    mNodeGrid.update(id, SpatialGrid::circleBounds(node.getPosition(), node.getRadius()));
+}
+
+void Graph::handleNodeDragging()
+{
+    Vector2 mouse = camera->screenToWorld(GetMousePosition());
+
+    if (IsMouseButtonPressed(MOUSE_BUTTON_LEFT)) {
+        // Buttons take the click first
+        for (auto& button : buttons) {
+            if (CheckCollisionPointRec(GetMousePosition(), button->getBounds())) {
+                return;
+            }
+        }
+
+        mDragNode = pickNode(mouse);
+        if (mDragNode != -1) {
+            mDragOffset = Vector2Subtract(mNodes[mDragNode]->getPosition(), mouse);
+        }
+    }
+
+    if (mDragNode == -1) {
+        return;
+    }
+
+    if (IsMouseButtonDown(MOUSE_BUTTON_LEFT)) {
+        mNodes[mDragNode]->setPosition(Vector2Add(mouse, mDragOffset));
+        mNodes[mDragNode]->setVelocity({0, 0});
+    }
+    else {
+        // Let the neighbours settle around the dropped node
+        mDragNode    = -1;
+        mTime        = 0;
+        mCoolDown    = WARM_COOL_DOWN;
+        mLayoutSaved = false;
+    }
+}
+
+uint64_t Graph::edgeKey(int from, int to)
+{
+    return (static_cast<uint64_t>(static_cast<uint32_t>(from)) << 32) | static_cast<uint32_t>(to);
+}
+
+int Graph::nodeId(const PolyNode* node)
+{
+    return static_cast<const GraphNode*>(node)->getId();
+}
+
+EdgeHandle Graph::findEdge(int from, int to) const
+{
+    auto it = mEdgeIndex.find(edgeKey(from, to));
+    if (it != mEdgeIndex.end()) {
+        return it->second;
+    }
+
+    if (!mIsDirected) {
+        it = mEdgeIndex.find(edgeKey(to, from));
+        if (it != mEdgeIndex.end()) {
+            return it->second;
+        }
+    }
+
+    return EdgeHandle();
+}
+
+void Graph::removeEdge(EdgeHandle handle)
+{
+    Edge* edge = mEdgeArena.get(handle);
+    if (!edge) {
+        return;
+    }
+
+    mEdgeIndex.erase(edgeKey(nodeId(edge->getFrom()), nodeId(edge->getTo())));
+    mEdgeGrid.remove(handle.getIndex());
+    edge->getTo()->removeEdgeIn(handle);
 }
\ No newline at end of file
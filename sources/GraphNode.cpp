@@ -6,12 +6,22 @@ float GraphNode::sRight  = 800.0f - MARGIN; // Default fallback
 float GraphNode::sTop    = MARGIN;
 float GraphNode::sBottom = 600.0f - MARGIN; // Default fallback
 
-GraphNode::GraphNode(Font font)
-    : PolyNode(font), mVelocity({0, 0})
+GraphNode::GraphNode(Font font, EdgeArena& edges)
+    : PolyNode(font, edges), mId(0), mVelocity({0, 0}), mPrevious({0, 0}), mCurrent({0, 0})
 {
     // Initialize the node with zero velocity
 }
 
+void GraphNode::setId(int id)
+{
+    mId = id;
+}
+
+int GraphNode::getId() const
+{
+    return mId;
+}
+
 void GraphNode::setVelocity(Vector2 velocity)
 {
     mVelocity = velocity;
@@ -22,33 +32,46 @@ Vector2 GraphNode::getVelocity() const
     return mVelocity;
 }
 
-void GraphNode::makeAdjacent(GraphNode* node)
+void GraphNode::setPosition(Vector2 position)
 {
-    // Skip if already adjacent
-    if (isAdjacent(*node))
-        return;
-
-    // Add to adjacent list
-    mAdjacent.push_back(node);
+    mPrevious = position;
+    mCurrent  = position;
+    PolyNode::setPosition(position);
+}
 
-    // Create visual edge
-    addEdgeOut(node);
+Vector2 GraphNode::getSimulatedPosition() const
+{
+    return mCurrent;
 }
 
-bool GraphNode::isAdjacent(const GraphNode& node) const
+bool GraphNode::interpolate(float alpha)
 {
-    return std::find(mAdjacent.begin(), mAdjacent.end(), &node) != mAdjacent.end();
+    Vector2 position = Vector2Lerp(mPrevious, mCurrent, alpha);
+    Vector2 drawn    = getPosition();
+    if (position.x == drawn.x && position.y == drawn.y)
+        return false;
+
+    PolyNode::setPosition(position);
+    return true;
 }
 
-const std::vector<GraphNode*>& GraphNode::getAdjacent() const
+bool GraphNode::isAdjacent(const GraphNode& node) const
 {
-    return mAdjacent;
+    for (EdgeHandle handle : getOutEdges()) {
+        if (getEdgeArena().get(handle)->getTo() == &node)
+            return true;
+    }
+    for (EdgeHandle handle : getInEdges()) {
+        if (getEdgeArena().get(handle)->getFrom() == &node)
+            return true;
+    }
+    return false;
 }
 
 Vector2 GraphNode::getRepulsion(const GraphNode& node) const
 {
     // Calculate distance vector between nodes
-    Vector2 distance = Vector2Subtract(getPosition(), node.getPosition());
+    Vector2 distance = Vector2Subtract(mCurrent, node.mCurrent);
     float magnitude  = Vector2Length(distance);
 
     // Avoid division by zero
@@ -67,7 +90,7 @@ Vector2 GraphNode::getRepulsion(const GraphNode& node) const
 Vector2 GraphNode::getAttraction(const GraphNode& node) const
 {
     // Calculate distance vector between nodes
-    Vector2 distance = Vector2Subtract(node.getPosition(), getPosition());
+    Vector2 distance = Vector2Subtract(node.mCurrent, mCurrent);
     float magnitude  = Vector2Length(distance);
 
     // Calculate force proportional to distance beyond the ideal length
@@ -83,9 +106,13 @@ Vector2 GraphNode::getTotalAttraction() const
 {
     Vector2 total = {0, 0};
 
-    // Sum attractions from all adjacent nodes
-    for (auto node : mAdjacent) {
-        total = Vector2Add(total, getAttraction(*node));
+    // Sum attractions from the other end of every incident edge
+    const EdgeArena& edges = getEdgeArena();
+    for (EdgeHandle handle : getOutEdges()) {
+        total = Vector2Add(total, getAttraction(*static_cast<const GraphNode*>(edges.get(handle)->getTo())));
+    }
+    for (EdgeHandle handle : getInEdges()) {
+        total = Vector2Add(total, getAttraction(*static_cast<const GraphNode*>(edges.get(handle)->getFrom())));
     }
 
     return total;
@@ -96,8 +123,13 @@ void GraphNode::update(float dt)
     // Call parent update to handle animations
     PolyNode::update(dt);
 
+    // Resting nodes don't move, so their edges stay clean
+    mPrevious = mCurrent;
+    if (mVelocity.x == 0 && mVelocity.y == 0)
+        return;
+
     // Apply velocity to position
-    Vector2 newPosition = Vector2Add(getPosition(), Vector2Scale(mVelocity, dt));
+    Vector2 newPosition = Vector2Add(mCurrent, Vector2Scale(mVelocity, dt));
 
     // Apply boundaries using static screen-aware values
     if (newPosition.x < sLeft)
@@ -109,10 +141,12 @@ void GraphNode::update(float dt)
     if (newPosition.y > sBottom)
         newPosition.y = sBottom;
 
-    setPosition(newPosition);
+    mCurrent = newPosition;
 
-    // Apply damping to velocity (optional)
-    mVelocity = Vector2Scale(mVelocity, 0.95f);
+    // Apply damping to velocity, the same per second whatever the tick rate
+    mVelocity = Vector2Scale(mVelocity, powf(DAMPING, dt / DAMPING_STEP));
+    if (Vector2LengthSqr(mVelocity) < REST_SPEED * REST_SPEED)
+        mVelocity = {0, 0};
 }
 
 void GraphNode::setScreenBoundaries(float left, float right, float top, float bottom)
@@ -0,0 +1,181 @@
+#include "../includes/LayoutCache.hpp"
+
+namespace {
+    // FNV-1a, 64-bit
+    constexpr uint64_t FNV_OFFSET = 14695981039346656037ull;
+    constexpr uint64_t FNV_PRIME  = 1099511628211ull;
+
+    void hashValue(uint64_t& hash, uint32_t value)
+    {
+        for (int i = 0; i < 4; i++) {
+            hash ^= (value >> (i * 8)) & 0xFF;
+            hash *= FNV_PRIME;
+        }
+    }
+
+    struct SidecarHeader {
+        uint32_t magic;
+        uint32_t version;
+        uint64_t fingerprint;
+        uint32_t nodes;
+        uint32_t edges;
+    };
+
+    struct SidecarEdge {
+        uint32_t from;
+        uint32_t to;
+    };
+}
+
+LayoutCache::LayoutCache()
+    : mFingerprint(0)
+{
+}
+
+uint64_t LayoutCache::fingerprint(int nodes, const EdgeList& edges)
+{
+    uint64_t hash = FNV_OFFSET;
+    hashValue(hash, static_cast<uint32_t>(nodes));
+    hashValue(hash, static_cast<uint32_t>(edges.size()));
+
+    for (const auto& edge : edges) {
+        hashValue(hash, static_cast<uint32_t>(edge.first));
+        hashValue(hash, static_cast<uint32_t>(edge.second));
+    }
+
+    return hash;
+}
+
+std::string LayoutCache::sidecarPath(const std::string& graphFile)
+{
+    return graphFile + ".layout";
+}
+
+int LayoutCache::maxNearNodes(int nodes)
+{
+    return nodes + static_cast<int>(nodes * NEAR_NODES);
+}
+
+bool LayoutCache::load(const std::string& path, int maxNodes)
+{
+    std::ifstream file(path, std::ios::binary | std::ios::ate);
+    if (!file.is_open()) {
+        return false;
+    }
+    uint64_t fileSize = static_cast<uint64_t>(file.tellg());
+    file.seekg(0);
+
+    SidecarHeader header;
+    if (!file.read(reinterpret_cast<char*>(&header), sizeof(header))) {
+        return false;
+    }
+
+    if (header.magic != MAGIC || header.version != VERSION) {
+        return false;
+    }
+
+    // Check the counts before allocating anything for them
+    uint64_t expectedSize = sizeof(header) + uint64_t(header.nodes) * sizeof(Vector2) + uint64_t(header.edges) * sizeof(SidecarEdge);
+    if (header.nodes > static_cast<uint32_t>(std::max(0, maxNodes)) || expectedSize != fileSize) {
+        return false;
+    }
+
+    std::vector<Vector2> positions(header.nodes);
+    std::vector<SidecarEdge> stored(header.edges);
+    if (!file.read(reinterpret_cast<char*>(positions.data()), positions.size() * sizeof(Vector2)) ||
+        !file.read(reinterpret_cast<char*>(stored.data()), stored.size() * sizeof(SidecarEdge))) {
+        return false;
+    }
+
+    EdgeList edges;
+    edges.reserve(stored.size());
+    for (const SidecarEdge& edge : stored) {
+        edges.emplace_back(static_cast<int>(edge.from), static_cast<int>(edge.to));
+    }
+
+    mFingerprint = header.fingerprint;
+    mPositions   = std::move(positions);
+    mEdges       = std::move(edges);
+    return true;
+}
+
+bool LayoutCache::save(const std::string& path) const
+{
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    if (!file.is_open()) {
+        return false;
+    }
+
+    std::vector<SidecarEdge> stored;
+    stored.reserve(mEdges.size());
+    for (const auto& edge : mEdges) {
+        stored.push_back(SidecarEdge{static_cast<uint32_t>(edge.first), static_cast<uint32_t>(edge.second)});
+    }
+
+    SidecarHeader header = {MAGIC, VERSION, mFingerprint, static_cast<uint32_t>(mPositions.size()), static_cast<uint32_t>(stored.size())};
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    file.write(reinterpret_cast<const char*>(mPositions.data()), mPositions.size() * sizeof(Vector2));
+    file.write(reinterpret_cast<const char*>(stored.data()), stored.size() * sizeof(SidecarEdge));
+
+    return file.good();
+}
+
+uint64_t LayoutCache::getFingerprint() const
+{
+    return mFingerprint;
+}
+
+int LayoutCache::getNumNodes() const
+{
+    return static_cast<int>(mPositions.size());
+}
+
+const std::vector<Vector2>& LayoutCache::getPositions() const
+{
+    return mPositions;
+}
+
+const LayoutCache::EdgeList& LayoutCache::getEdges() const
+{
+    return mEdges;
+}
+
+bool LayoutCache::matches(uint64_t fingerprint, int nodes) const
+{
+    return mFingerprint == fingerprint && getNumNodes() == nodes;
+}
+
+bool LayoutCache::isNear(int nodes, const EdgeList& edges) const
+{
+    if (std::abs(getNumNodes() - nodes) > static_cast<int>(std::max(nodes, getNumNodes()) * NEAR_NODES)) {
+        return false;
+    }
+
+    // Both lists are sorted, count the common edges against their union
+    size_t common = 0;
+    auto a        = mEdges.begin();
+    auto b        = edges.begin();
+    while (a != mEdges.end() && b != edges.end()) {
+        if (*a < *b) {
+            ++a;
+        }
+        else if (*b < *a) {
+            ++b;
+        }
+        else {
+            common++;
+            ++a;
+            ++b;
+        }
+    }
+
+    size_t total = mEdges.size() + edges.size() - common;
+    return total == 0 || common >= total * NEAR_EDGES;
+}
+
+void LayoutCache::setLayout(uint64_t fingerprint, const std::vector<Vector2>& positions, const EdgeList& edges)
+{
+    mFingerprint = fingerprint;
+    mPositions   = positions;
+    mEdges       = edges;
+}
@@ -18,6 +18,7 @@ using namespace std;
 
 namespace {
     AnimationList gAnimList;
+    TweenPool gTweens; // Position tracks of the current list animation
     bool gPendingInsertion = false;
     int gPendingInsertValue = 0;
     bool gInsertionDone = false;
@@ -25,6 +26,8 @@ namespace {
     std::vector<Vector2> gOldPositions;
     std::vector<Vector2> gNewPositions;
     std::vector<Vector2> gCurrentPositions;
+    int gAnimatedHighlight = -1; // Node highlighted by the current list animation
+    const float gAddHighlightDuration = 0.5f;
     bool gIsAnimating = false;
     bool gSearchActive = false;
     int gSearchValue = 0;
@@ -46,6 +49,8 @@ namespace {
     bool gDeleteNotFound = false;
     float gDeleteStatusTimer = 0.0f;
     const float gDeleteStatusDuration = 1.0f;
+    bool gFastForward = false;
+    const double gFastForwardBudget = 0.008; // Seconds of fast forward work per frame
     bool showInsertMenu = false;
     bool showSearchDialog = false;
     bool showDeleteDialog = false;
@@ -79,7 +84,10 @@ int GetValDialogBox(const char* caption, std::string& inputText, bool& inputActi
     int boxWidth = (int)rect.width;
     int boxHeight = (int)rect.height;
 
-    DrawText(caption, posX, posY - 25, 20, BLACK);
+    // Drawn with the next frame, the queue is flushed after the scene draws
+    RenderQueue& queue = Application::getInstance()->getRenderQueue();
+    queue.setLayer(RenderQueue::LAYER_TEXT);
+    queue.text(caption, posX, posY - 25, 20, BLACK);
     Rectangle inputBox = { (float)posX, (float)posY, (float)boxWidth, (float)boxHeight };
 
     if (IsMouseButtonPressed(MOUSE_LEFT_BUTTON)) {
@@ -88,14 +96,17 @@ int GetValDialogBox(const char* caption, std::string& inputText, bool& inputActi
     }
 
     Color boxColor = inputActive ? RAYWHITE : LIGHTGRAY;
-    DrawRectangleRec(inputBox, boxColor);
-    DrawRectangleLines(posX, posY, boxWidth, boxHeight, BLACK);
-    DrawText(inputText.c_str(), posX + 5, posY + 5, 20, BLACK);
+    queue.setLayer(RenderQueue::LAYER_SHAPES);
+    queue.rectangle(inputBox, boxColor);
+    queue.setLayer(RenderQueue::LAYER_OUTLINES);
+    queue.rectangleLines(inputBox, 1, BLACK);
+    queue.setLayer(RenderQueue::LAYER_TEXT);
+    queue.text(inputText.c_str(), posX + 5, posY + 5, 20, BLACK);
 
     // Blinking cursor
     if (inputActive && (((int)(GetTime() * 2) % 2) == 0)) {
         int textWidth = MeasureText(inputText.c_str(), 20);
-        DrawText("|", posX + 5 + textWidth, posY + 5, 20, BLACK);
+        queue.text("|", posX + 5 + textWidth, posY + 5, 20, BLACK);
     }
 
     if (inputActive) {
@@ -156,7 +167,7 @@ Vector2 LinkedList::GetPosCLLNode(int totalNodes, int index, float centerX, floa
 // ------------------------------------------------------------------------
 // LinkedList Implementation
 // ------------------------------------------------------------------------
-LinkedList::LinkedList() : head(nullptr), camera(nullptr) { }
+LinkedList::LinkedList() : head(nullptr), camera(nullptr), random(RandomService::stream(Scene::LINKEDLIST)) { }
 
 LinkedList::~LinkedList() {
     ClearList();
@@ -168,10 +179,12 @@ void LinkedList::DrawList(const std::vector<Vector2>& positions, int highlightIn
     const float arrowHeadLength = 10.0f;
     const float arrowHeadAngle = PI / 6;
     int count = positions.size();
+    RenderQueue& queue = Application::getInstance()->getRenderQueue();
 
-    camera->beginMode();
+    queue.beginWorld(camera->getCamera());
 
     // Draw lines
+    queue.setLayer(RenderQueue::LAYER_BACKGROUND);
     if (count >= 2) {
         for (int i = 0; i < count; i++) {
             int nextIndex = (i + 1) % count;
@@ -184,14 +197,15 @@ void LinkedList::DrawList(const std::vector<Vector2>& positions, int highlightIn
                 dir.y /= length;
             }
             Vector2 lineEnd = { end.x - dir.x * nodeRadius, end.y - dir.y * nodeRadius };
-            DrawLineEx(start, lineEnd, 2, BLACK);
+            queue.line(start, lineEnd, 2, BLACK);
         }
     }
 
     // Draw nodes
     for (int i = 0; i < count; i++) {
         Color nodeColor = (i == highlightIndex) ? YELLOW : LIGHTGRAY;
-        DrawCircleV(positions[i], (float)nodeRadius, nodeColor);
+        queue.setLayer(RenderQueue::LAYER_SHAPES);
+        queue.circle(positions[i], (float)nodeRadius, nodeColor);
 
         if (head != nullptr) {
             // We always start enumerating from "head"
@@ -200,7 +214,8 @@ void LinkedList::DrawList(const std::vector<Vector2>& positions, int highlightIn
                 cur = cur->next;
             std::string text = std::to_string(cur->data);
             int textWidth = MeasureText(text.c_str(), 20);
-            DrawText(text.c_str(),
+            queue.setLayer(RenderQueue::LAYER_TEXT);
+            queue.text(text.c_str(),
                 (int)(positions[i].x - textWidth / 2),
                 (int)(positions[i].y - 10),
                 20,
@@ -208,7 +223,8 @@ void LinkedList::DrawList(const std::vector<Vector2>& positions, int highlightIn
         }
     }
 
-    // Draw arrow heads
+    // Draw arrow heads, they sit on the node borders so text can't cover them
+    queue.setLayer(RenderQueue::LAYER_OUTLINES);
     if (count >= 2) {
         for (int i = 0; i < count; i++) {
             int nextIndex = (i + 1) % count;
@@ -232,11 +248,11 @@ void LinkedList::DrawList(const std::vector<Vector2>& positions, int highlightIn
                 arrowPos.x - arrowHeadLength * cosf(angle2),
                 arrowPos.y - arrowHeadLength * sinf(angle2)
             };
-            DrawTriangle(arrowPos, arrowPoint1, arrowPoint2, BLACK);
+            queue.triangle(arrowPos, arrowPoint1, arrowPoint2, BLACK);
         }
     }
 
-    camera->endMode();
+    queue.endWorld();
 }
 
 void LinkedList::ClearList() {
@@ -300,27 +316,16 @@ void LinkedList::DrawNode(int value) {
         gNewPositions.push_back(GetPosCLLNode(totalNodes, i, centerX, centerY, radius));
     }
 
-    // Animate from old to new
-    Animation animInsertion(
-        [=](float progress) {
-            std::vector<Vector2> interpPositions;
-            for (int i = 0; i < gInitialNodeCount; i++) {
-                Vector2 interp = {
-                    gOldPositions[i].x + (gNewPositions[i].x - gOldPositions[i].x) * progress,
-                    gOldPositions[i].y + (gNewPositions[i].y - gOldPositions[i].y) * progress
-                };
-                interpPositions.push_back(interp);
-            }
-            Vector2 newNodePos = {
-                centerX + (gNewPositions[gInitialNodeCount].x - centerX) * progress,
-                centerY + (gNewPositions[gInitialNodeCount].y - centerY) * progress
-            };
-            interpPositions.push_back(newNodePos);
-            gCurrentPositions = interpPositions;
-            gIsAnimating = true;
-        },
-        1.0f
-    );
+    // Animate from old to new, the new node grows out of the center
+    gAnimList.clear();
+    gTweens.clear();
+    gCurrentPositions.assign(totalNodes, Vector2{ centerX, centerY });
+    for (int i = 0; i < count; i++) {
+        gTweens.add(&gCurrentPositions[i], gOldPositions[i], gNewPositions[i]);
+    }
+    gTweens.add(&gCurrentPositions[count], Vector2{ centerX, centerY }, gNewPositions[count]);
+    Animation animInsertion(gTweens, 0, static_cast<uint32_t>(gTweens.size()), 1.0f);
+    gIsAnimating = true;
     gAnimList.push(animInsertion);
     gAnimList.play();
     gInsertionDone = false;
@@ -354,10 +359,9 @@ void LinkedList::GetInputFromFile(const std::string& filename) {
 }
 
 void LinkedList::MakeRandomList() {
-    srand((unsigned)time(0));
     const int numNodes = 10;
     for (int i = 0; i < numNodes; i++) {
-        int randomValue = rand() % 100;
+        int randomValue = random.nextInt(0, 99);
         pendingOps.push([this, randomValue]() {
             DrawNode(randomValue);
             });
@@ -401,6 +405,11 @@ void LinkedList::DeleteNode(int deleteValue) {
 void LinkedList::AddNode(int dest, int newVal) {
     if (head == nullptr)
         return;
+    // Tracks of a running animation point into gCurrentPositions, wait for it
+    if (gAnimList.isPlaying()) {
+        pendingOps.push([=]() { AddNode(dest, newVal); });
+        return;
+    }
     int index = -1;
     int i = 0;
     Node* cur = head;
@@ -431,25 +440,28 @@ void LinkedList::AddNode(int dest, int newVal) {
     for (int i = 0; i < newTotal; i++) {
         gNewPositions.push_back(GetPosCLLNode(newTotal, i, centerX, centerY, radius));
     }
-    Animation animAddition(
-        [=](float progress) {
-            vector<Vector2> interpPositions;
-            for (int i = 0; i <= index; i++) {
-                Vector2 interp = { gOldPositions[i].x + (gNewPositions[i].x - gOldPositions[i].x) * progress,
-                    gOldPositions[i].y + (gNewPositions[i].y - gOldPositions[i].y) * progress };
-                interpPositions.push_back(interp);
-            }
-            Vector2 newNodePos = gNewPositions[index + 1];
-            interpPositions.push_back(newNodePos);
-            for (int i = index + 1; i < count; i++) {
-                Vector2 interp = { gOldPositions[i].x + (gNewPositions[i + 1].x - gOldPositions[i].x) * progress,
-                    gOldPositions[i].y + (gNewPositions[i + 1].y - gOldPositions[i].y) * progress };
-                interpPositions.push_back(interp);
-            }
-            gCurrentPositions = interpPositions;
-            gIsAnimating = true;
-        }, 1.0f);
-    gAnimList.push(animAddition);
+    // Nodes after the insertion point shift one slot, the new node appears in place
+    gAnimList.clear();
+    gTweens.clear();
+    gCurrentPositions.assign(newTotal, gNewPositions[index + 1]);
+    for (int i = 0; i <= index; i++) {
+        gCurrentPositions[i] = gOldPositions[i];
+        gTweens.add(&gCurrentPositions[i], gOldPositions[i], gNewPositions[i]);
+    }
+    for (int i = index + 1; i < count; i++) {
+        gCurrentPositions[i + 1] = gOldPositions[i];
+        gTweens.add(&gCurrentPositions[i + 1], gOldPositions[i], gNewPositions[i + 1]);
+    }
+    // Point at the destination, then keep it lit while its neighbours move
+    auto highlight = [index](float duration) {
+        return Animation([index](float progress) { gAnimatedHighlight = progress < 1.0f ? index : -1; }, duration);
+    };
+    Animation animMove(gTweens, 0, static_cast<uint32_t>(gTweens.size()), 1.0f);
+    gIsAnimating = true;
+    gAnimList.push(AnimationGroup::sequence({
+        highlight(gAddHighlightDuration),
+        AnimationGroup::parallel({ highlight(animMove.getDuration()), animMove }),
+    }));
     gAnimList.play();
     pendingOps.push([=]() {
         Node* newNode = new Node{ newVal, nullptr };
@@ -458,6 +470,7 @@ void LinkedList::AddNode(int dest, int newVal) {
         newNode->next = target->next;
         target->next = newNode;
         gIsAnimating = false;
+        gAnimatedHighlight = -1;
         gCurrentPositions.clear();
         });
 }
@@ -490,7 +503,7 @@ void LinkedList::init() {
     int panelX = margin;
     int panelY = screenHeight / 2 + margin;
     int panelAvailableHeight = screenHeight / 2 - 2 * margin;
-    int buttonHeight = (panelAvailableHeight - 5 * margin) / 6;
+    int buttonHeight = (panelAvailableHeight - 6 * margin) / 7;
     int buttonWidth = panelWidth - 2 * margin;
     auto initBtn = make_unique<ActionButton>(Rectangle{ (float)panelX, (float)panelY, (float)buttonWidth, (float)buttonHeight },
         "Initialize", baseFontSize, [this]() { ClearList(); MakeRandomList(); },
@@ -510,82 +523,130 @@ void LinkedList::init() {
     auto clearBtn = make_unique<ActionButton>(Rectangle{ (float)panelX, (float)(panelY + (buttonHeight + margin) * 5), (float)buttonWidth, (float)buttonHeight },
         "Clear List", baseFontSize, [this]() { ClearList(); },
         RAYWHITE, SKYBLUE, BLUE, BLACK);
+    auto skipBtn = make_unique<ActionButton>(Rectangle{ (float)panelX, (float)(panelY + (buttonHeight + margin) * 6), (float)buttonWidth, (float)buttonHeight },
+        "Skip Animations", baseFontSize, [this]() { gFastForward = true; },
+        RAYWHITE, SKYBLUE, BLUE, BLACK);
     buttons.push_back(move(initBtn));
     buttons.push_back(move(addBtn));
     buttons.push_back(move(updateBtn));
     buttons.push_back(move(searchBtn));
     buttons.push_back(move(deleteBtn));
     buttons.push_back(move(clearBtn));
+    buttons.push_back(move(skipBtn));
     addComponent<ReturnButtonComponent>(Scene::MENU, baseFontSize)->init();
     camera = addComponent<Camera2DComponent>();
     camera->init();
     head = nullptr;
     gAnimList.clear();
+    gTweens.clear();
     gPendingInsertion = false;
+    gAnimatedHighlight = -1;
+    gFastForward = false;
+    gAnimList.setInstant(false);
     while (!pendingOps.empty()) { pendingOps.pop(); }
 }
 
-void LinkedList::update() {
-    updateComponents();
-    if (IsWindowResized()) { updateFontSize(); handleComponentsResize(); }
-    for (auto& button : buttons) { button->update(); }
-    camera->update();
-    gAnimList.update(GetFrameTime());
-    if (gPendingInsertion && !gAnimList.isPlaying() && !gInsertionDone) {
-        Node* newNode = new Node{ gPendingInsertValue, nullptr };
-        if (head == nullptr) { head = newNode; newNode->next = head; }
-        else { Node* last = head; while (last->next != head) last = last->next; last->next = newNode; newNode->next = head; }
-        gInsertionDone = true;
-        gPendingInsertion = false;
-        gIsAnimating = false;
-        gCurrentPositions.clear();
-    }
-    if (!gAnimList.isPlaying() && !pendingOps.empty()) { auto op = pendingOps.front(); pendingOps.pop(); op(); }
-    if (gSearchActive) {
-        float dt = GetFrameTime();
-        int count = 0;
-        if (head != nullptr) { Node* temp = head; do { count++; temp = temp->next; } while (temp != head); }
-        if (count > 0) {
-            if (gSearchIndex < count) {
-                gSearchTimer += dt;
-                if (gSearchTimer >= gSearchThreshold) {
-                    Node* cur = head;
-                    for (int j = 0; j < gSearchIndex; j++) cur = cur->next;
-                    if (cur->data == gSearchValue) { gSearchFound = true; }
-                    else { gSearchIndex++; gSearchTimer = 0.0f; }
-                }
+void LinkedList::CompletePendingInsertion() {
+    if (!gPendingInsertion || gAnimList.isPlaying() || gInsertionDone) return;
+    Node* newNode = new Node{ gPendingInsertValue, nullptr };
+    if (head == nullptr) { head = newNode; newNode->next = head; }
+    else { Node* last = head; while (last->next != head) last = last->next; last->next = newNode; newNode->next = head; }
+    gInsertionDone = true;
+    gPendingInsertion = false;
+    gIsAnimating = false;
+    gCurrentPositions.clear();
+}
+
+void LinkedList::StepSearch(float dt) {
+    int count = 0;
+    if (head != nullptr) { Node* temp = head; do { count++; temp = temp->next; } while (temp != head); }
+    if (count > 0) {
+        if (gSearchIndex < count) {
+            gSearchTimer += dt;
+            if (gSearchTimer >= gSearchThreshold) {
+                Node* cur = head;
+                for (int j = 0; j < gSearchIndex; j++) cur = cur->next;
+                if (cur->data == gSearchValue) { gSearchFound = true; }
+                else { gSearchIndex++; gSearchTimer = 0.0f; }
             }
-            else { gSearchNotFound = true; }
-            if (gSearchFound) { gSearchFoundTimer += dt; if (gSearchFoundTimer >= gSearchFoundDuration) gSearchActive = false; }
-            if (gSearchNotFound) { gSearchNotFoundTimer += dt; if (gSearchNotFoundTimer >= gSearchNotFoundDuration) gSearchActive = false; }
         }
+        else { gSearchNotFound = true; }
+        if (gSearchFound) { gSearchFoundTimer += dt; if (gSearchFoundTimer >= gSearchFoundDuration) gSearchActive = false; }
+        if (gSearchNotFound) { gSearchNotFoundTimer += dt; if (gSearchNotFoundTimer >= gSearchNotFoundDuration) gSearchActive = false; }
     }
-    if (gDeleteActive) {
-        float dt = GetFrameTime();
-        int count = 0;
-        if (head != nullptr) { Node* temp = head; do { count++; temp = temp->next; } while (temp != head); }
-        if (count > 0) {
-            if (gDeleteIndex < count) {
-                gDeleteTimer += dt;
-                if (gDeleteTimer >= gDeleteThreshold) {
-                    Node* cur = head;
-                    for (int j = 0; j < gDeleteIndex; j++) cur = cur->next;
-                    if (cur->data == gDeleteValue) {
-                        if (head->next == head) { delete head; head = nullptr; }
-                        else {
-                            if (cur == head) { Node* last = head; while (last->next != head) last = last->next; head = head->next; last->next = head; delete cur; }
-                            else { Node* prev = head; for (int j = 0; j < gDeleteIndex - 1; j++) prev = prev->next; prev->next = cur->next; delete cur; }
-                        }
-                        gDeleteFound = true;
+}
+
+void LinkedList::StepDelete(float dt) {
+    int count = 0;
+    if (head != nullptr) { Node* temp = head; do { count++; temp = temp->next; } while (temp != head); }
+    if (count > 0) {
+        if (gDeleteIndex < count) {
+            gDeleteTimer += dt;
+            if (gDeleteTimer >= gDeleteThreshold) {
+                Node* cur = head;
+                for (int j = 0; j < gDeleteIndex; j++) cur = cur->next;
+                if (cur->data == gDeleteValue) {
+                    if (head->next == head) { delete head; head = nullptr; }
+                    else {
+                        if (cur == head) { Node* last = head; while (last->next != head) last = last->next; head = head->next; last->next = head; delete cur; }
+                        else { Node* prev = head; for (int j = 0; j < gDeleteIndex - 1; j++) prev = prev->next; prev->next = cur->next; delete cur; }
                     }
-                    else { gDeleteIndex++; gDeleteTimer = 0.0f; }
+                    gDeleteFound = true;
                 }
+                else { gDeleteIndex++; gDeleteTimer = 0.0f; }
             }
-            else { gDeleteNotFound = true; }
-            gDeleteStatusTimer += dt;
-            if (gDeleteStatusTimer >= gDeleteStatusDuration) { gDeleteActive = false; gDeleteStatusTimer = 0.0f; }
         }
+        else { gDeleteNotFound = true; }
+        gDeleteStatusTimer += dt;
+        if (gDeleteStatusTimer >= gDeleteStatusDuration) { gDeleteActive = false; gDeleteStatusTimer = 0.0f; }
     }
+}
+
+/*
+    Fast forward: only the final state of every queued operation is applied,
+    as many operations as fit in the time budget, then drawing resumes.
+*/
+void LinkedList::FastForward(double budget) {
+    gAnimList.setInstant(true);
+    double deadline = GetTime() + budget;
+    do {
+        gAnimList.finish();
+        CompletePendingInsertion();
+        if (head == nullptr) { gSearchActive = false; gDeleteActive = false; } // Would never finish
+        if (gSearchActive) { StepSearch(gSearchThreshold); }
+        else if (gDeleteActive) { StepDelete(gDeleteThreshold); }
+        else if (!pendingOps.empty()) { auto op = pendingOps.front(); pendingOps.pop(); op(); }
+        else { gFastForward = false; break; }
+    } while (GetTime() < deadline);
+    if (!gFastForward) { gAnimList.setInstant(false); }
+}
+
+void LinkedList::loadDemo() {
+    MakeRandomList();
+}
+
+// Animations, running operations and open dialogs (blinking cursor) redraw every frame
+bool LinkedList::isAnimating() const {
+    return gIsAnimating || gSearchActive || gDeleteActive || gFastForward || gAnimList.isPlaying() || !pendingOps.empty() ||
+           showSearchDialog || showDeleteDialog || showAddDestinationDialog || showAddValueDialog ||
+           showUpdateDestinationDialog || showUpdateNewValueDialog;
+}
+
+void LinkedList::fixedUpdate(float dt) {
+    gAnimList.update(dt);
+}
+
+void LinkedList::update() {
+    updateComponents();
+    if (IsWindowResized()) { updateFontSize(); handleComponentsResize(); }
+    for (auto& button : buttons) { button->update(); }
+    camera->update();
+    if (gFastForward) { FastForward(gFastForwardBudget); }
+    CompletePendingInsertion();
+    if (!gAnimList.isPlaying() && !pendingOps.empty()) { auto op = pendingOps.front(); pendingOps.pop(); op(); }
+    float dt = Application::getInstance()->getFrameDelta();
+    if (gSearchActive) { StepSearch(dt); }
+    if (gDeleteActive) { StepDelete(dt); }
     int panelY = GetScreenHeight() / 2 + 10;
     int dialogY = panelY - 40;
     Rectangle dialogRect = { 10, (float)dialogY, 150, 30 };
@@ -631,19 +692,21 @@ void LinkedList::draw() {
     }
     if (gSearchActive) { DrawList(positions, gSearchIndex, head); }
     else if (gDeleteActive) { DrawList(positions, gDeleteIndex, head); }
-    else if (gIsAnimating && !gCurrentPositions.empty()) { DrawList(gCurrentPositions, -1, head); }
+    else if (gIsAnimating && !gCurrentPositions.empty()) { DrawList(gCurrentPositions, gAnimatedHighlight, head); }
     else { DrawList(positions, -1, head); }
+    RenderQueue& queue = Application::getInstance()->getRenderQueue();
+    queue.setLayer(RenderQueue::LAYER_TEXT);
     if (gSearchActive) {
-        if (gSearchFound) { DrawText("Node Found!", 10, GetScreenHeight() / 2 - 40, 20, GREEN); }
-        else if (gSearchNotFound) { DrawText("Node Not Found!", 10, GetScreenHeight() / 2 - 40, 20, RED); }
-        else { DrawText(TextFormat("Searching for %d...", gSearchValue), 10, GetScreenHeight() / 2 - 40, 20, BLACK); }
+        if (gSearchFound) { queue.text("Node Found!", 10, GetScreenHeight() / 2 - 40, 20, GREEN); }
+        else if (gSearchNotFound) { queue.text("Node Not Found!", 10, GetScreenHeight() / 2 - 40, 20, RED); }
+        else { queue.text(TextFormat("Searching for %d...", gSearchValue), 10, GetScreenHeight() / 2 - 40, 20, BLACK); }
     }
     if (gDeleteActive) {
-        if (gDeleteFound) { DrawText("Node Deleted!", 10, GetScreenHeight() / 2 - 40, 20, GREEN); }
-        else if (gDeleteNotFound) { DrawText("Node Not Found!", 10, GetScreenHeight() / 2 - 40, 20, RED); }
-        else { DrawText(TextFormat("Deleting %d...", gDeleteValue), 10, GetScreenHeight() / 2 - 40, 20, BLACK); }
+        if (gDeleteFound) { queue.text("Node Deleted!", 10, GetScreenHeight() / 2 - 40, 20, GREEN); }
+        else if (gDeleteNotFound) { queue.text("Node Not Found!", 10, GetScreenHeight() / 2 - 40, 20, RED); }
+        else { queue.text(TextFormat("Deleting %d...", gDeleteValue), 10, GetScreenHeight() / 2 - 40, 20, BLACK); }
     }
-    DrawText("Linked List Visualization", 10, 10, 20, BLACK);
+    queue.text("Linked List Visualization", 10, 10, 20, BLACK);
     for (auto& button : buttons) { button->draw(); }
     drawComponents();
 }
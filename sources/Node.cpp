@@ -1,19 +1,14 @@
 #include "../includes/Node.hpp"
 
-PolyNode::PolyNode(Font font)
-    : mFont(font),
-      mData(""),
-      mLabel(""),
+PolyNode::PolyNode(Font font, EdgeArena& edges)
+    : mDataDirty(false),
       mPosition({0, 0}),
       mRadius(30.0f),
+      mStyle(NodeStyleTable::intern(NodeStyleTable::makeDefault(font))),
+      mHighlight(Highlight::None),
+      mEdgeArena(&edges),
       mScale(1.0f),
-      mTargetScale(1.0f),
-      mFontSize(20.0f),
-      mBaseColor(WHITE),
-      mCurrentColor(WHITE),
-      mTextColor(BLACK),
-      mHighlightPrimaryColor(RED),
-      mHighlightSecondaryColor(BLUE)
+      mTargetScale(1.0f)
 {
 }
 
@@ -25,17 +20,22 @@ PolyNode::~PolyNode()
 // Data management
 std::string PolyNode::getData() const
 {
-    return mData;
+    return mDataDirty ? mValue.toString() : mData.getText();
 }
 
 int PolyNode::getIntData() const
 {
-    try {
-        return std::stoi(mData);
-    }
-    catch (const std::exception&) {
+    // Out of range reads as 0, as std::stoi's exception did
+    int64_t value = mValue.asInt();
+    if (value < INT_MIN || value > INT_MAX) {
         return 0;
     }
+    return static_cast<int>(value);
+}
+
+const NodeValue& PolyNode::getValue() const
+{
+    return mValue;
 }
 
 float PolyNode::getRadius() const
@@ -43,24 +43,44 @@ float PolyNode::getRadius() const
     return mRadius * mScale;
 }
 
+Color PolyNode::getFillColor() const
+{
+    const NodeStyle& style = NodeStyleTable::get(mStyle);
+    switch (mHighlight) {
+        case Highlight::Primary:
+            return style.highlightPrimaryColor;
+        case Highlight::Secondary:
+            return style.highlightSecondaryColor;
+        default:
+            return style.baseColor;
+    }
+}
+
+Color PolyNode::getOutlineColor() const
+{
+    return NodeStyleTable::get(mStyle).outlineColor;
+}
+
 void PolyNode::setData(const std::string& data)
 {
-    mData = data;
-    // Set animation scale effect for data change
-    mTargetScale = 1.2f;
+    setValue(NodeValue::fromString(data));
 }
 
-void PolyNode::setData(int data)
+void PolyNode::setValue(const NodeValue& value)
 {
-    setData(std::to_string(data));
+    // Text is rebuilt lazily, so a burst of writes formats only once
+    mValue     = value;
+    mDataDirty = true;
+    // Set animation scale effect for data change
+    mTargetScale = 1.2f;
 }
 
 void PolyNode::swapData(PolyNode* node)
 {
     if (node) {
-        std::string temp = mData;
-        mData            = node->mData;
-        node->mData      = temp;
+        std::swap(mValue, node->mValue);
+        std::swap(mData, node->mData);
+        std::swap(mDataDirty, node->mDataDirty);
 
         // Set animation scale effect for both nodes
         mTargetScale       = 1.2f;
@@ -70,12 +90,13 @@ void PolyNode::swapData(PolyNode* node)
 
 void PolyNode::setLabel(const std::string& label)
 {
-    mLabel = label;
+    const NodeStyle& style = NodeStyleTable::get(mStyle);
+    mLabel.setText(label, style.font, style.labelFontSize, style.spacing);
 }
 
 void PolyNode::setLabel(int label)
 {
-    mLabel = std::to_string(label);
+    setLabel(std::to_string(label));
 }
 
 void PolyNode::setPoint(int points)
@@ -85,22 +106,15 @@ void PolyNode::setPoint(int points)
 
 void PolyNode::highlight(Highlight type)
 {
-    switch (type) {
-        case Highlight::None:
-            mCurrentColor = mBaseColor;
-            break;
-        case Highlight::Primary:
-            mCurrentColor = mHighlightPrimaryColor;
-            break;
-        case Highlight::Secondary:
-            mCurrentColor = mHighlightSecondaryColor;
-            break;
-    }
+    mHighlight = type;
 }
 
 void PolyNode::setRadius(float radius)
 {
-    mRadius = radius;
+    if (mRadius != radius) {
+        mRadius = radius;
+        markEdgesDirty();
+    }
 }
 
 void PolyNode::resetDataScale()
@@ -108,6 +122,30 @@ void PolyNode::resetDataScale()
     mTargetScale = 1.0f;
 }
 
+// Style management
+void PolyNode::setStyle(uint16_t style)
+{
+    if (mStyle == style) {
+        return;
+    }
+
+    // Text sizes depend on the font, measure again
+    mStyle                 = style;
+    const NodeStyle& looks = NodeStyleTable::get(mStyle);
+    mData.remeasure(looks.font, looks.fontSize, looks.spacing);
+    mLabel.remeasure(looks.font, looks.labelFontSize, looks.spacing);
+}
+
+uint16_t PolyNode::getStyle() const
+{
+    return mStyle;
+}
+
+PolyNode::Highlight PolyNode::getHighlight() const
+{
+    return mHighlight;
+}
+
 // Edge management
 void PolyNode::addEdgeOut(PolyNode* to, int type)
 {
@@ -115,111 +153,129 @@ void PolyNode::addEdgeOut(PolyNode* to, int type)
         return;
 
     // Check if edge already exists
-    for (auto& edge : outEdges) {
-        if (edge->getTo() == to) {
-            return; // Edge already exists
-        }
+    if (getEdgeOut(to)) {
+        return;
     }
 
     // Create new edge
-    std::shared_ptr<Edge> newEdge = std::make_shared<Edge>(this, to, type);
-    outEdges.push_back(newEdge);
-    to->addEdgeIn(newEdge);
+    EdgeHandle handle = mEdgeArena->create(this, to, type);
+    Edge* edge        = mEdgeArena->get(handle);
+    if (!edge)
+        return;
+    edge->setOutSlot(static_cast<uint32_t>(outEdges.size()));
+    outEdges.push_back(handle);
+    to->addEdgeIn(handle);
 }
 
-void PolyNode::addEdgeIn(std::shared_ptr<Edge> edge)
+void PolyNode::addEdgeIn(EdgeHandle edge)
 {
-    if (edge) {
+    Edge* inEdge = mEdgeArena->get(edge);
+    if (inEdge) {
+        inEdge->setInSlot(static_cast<uint32_t>(inEdges.size()));
         inEdges.push_back(edge);
     }
 }
 
 void PolyNode::removeEdgeOut(PolyNode* to)
 {
-    if (!to)
+    Edge* edge = getEdgeOut(to);
+    if (!edge)
         return;
 
-    auto it = std::find_if(outEdges.begin(), outEdges.end(),
-                           [to](const std::shared_ptr<Edge>& edge) { return edge->getTo() == to; });
-
-    if (it != outEdges.end()) {
-        // Remove from destination's inEdges
-        PolyNode* toNode = (*it)->getTo();
-        if (toNode) {
-            toNode->removeEdgeIn(*it);
-        }
-
-        // Remove from our outEdges
-        outEdges.erase(it);
-    }
+    // Unlink from both endpoints, then release the edge
+    EdgeHandle handle = edge->getHandle();
+    to->detachIn(edge->getInSlot());
+    detachOut(edge->getOutSlot());
+    mEdgeArena->destroy(handle);
 }
 
-void PolyNode::removeEdgeIn(std::shared_ptr<Edge> edge)
+void PolyNode::removeEdgeIn(EdgeHandle edge)
 {
-    auto it = std::find(inEdges.begin(), inEdges.end(), edge);
-    if (it != inEdges.end()) {
-        inEdges.erase(it);
-    }
+    Edge* inEdge = mEdgeArena->get(edge);
+    if (!inEdge || inEdge->getTo() != this)
+        return;
+
+    inEdge->getFrom()->detachOut(inEdge->getOutSlot());
+    detachIn(inEdge->getInSlot());
+    mEdgeArena->destroy(edge);
 }
 
 void PolyNode::removeAllEdges()
 {
-    // Clear outgoing edges first (which will also remove corresponding incoming edges)
+    // Clear outgoing edges first
     while (!outEdges.empty()) {
-        removeEdgeOut(outEdges[0]->getTo());
+        Edge* edge = mEdgeArena->get(outEdges.back());
+        edge->getTo()->detachIn(edge->getInSlot());
+        mEdgeArena->destroy(outEdges.back());
+        outEdges.pop_back();
     }
 
-    // Clear any remaining incoming edges (shouldn't be necessary if all nodes follow this pattern)
-    inEdges.clear();
+    // Then incoming edges, which also live in their source's outEdges
+    while (!inEdges.empty()) {
+        Edge* edge = mEdgeArena->get(inEdges.back());
+        edge->getFrom()->detachOut(edge->getOutSlot());
+        mEdgeArena->destroy(inEdges.back());
+        inEdges.pop_back();
+    }
 }
 
-void PolyNode::highlightEdge(PolyNode* to, bool highlight)
+Edge* PolyNode::getEdgeOut(PolyNode* to)
 {
-    auto it = std::find_if(outEdges.begin(), outEdges.end(),
-                           [to](const std::shared_ptr<Edge>& edge) { return edge->getTo() == to; });
+    if (!to)
+        return nullptr;
+
+    for (EdgeHandle handle : outEdges) {
+        Edge* edge = mEdgeArena->get(handle);
+        if (edge->getTo() == to) {
+            return edge;
+        }
+    }
+    return nullptr;
+}
 
-    if (it != outEdges.end()) {
-        (*it)->setHighlight(highlight);
+void PolyNode::highlightEdge(PolyNode* to, bool highlight)
+{
+    Edge* edge = getEdgeOut(to);
+    if (edge) {
+        edge->setHighlight(highlight);
     }
 }
 
 void PolyNode::setEdgeWeight(PolyNode* to, int weight)
 {
-    auto it = std::find_if(outEdges.begin(), outEdges.end(),
-                           [to](const std::shared_ptr<Edge>& edge) { return edge->getTo() == to; });
-
-    if (it != outEdges.end()) {
-        (*it)->setWeight(weight);
+    Edge* edge = getEdgeOut(to);
+    if (edge) {
+        edge->setWeight(weight);
     }
 }
 
 void PolyNode::setEdgeType(PolyNode* to, int type)
 {
-    auto it = std::find_if(outEdges.begin(), outEdges.end(),
-                           [to](const std::shared_ptr<Edge>& edge) { return edge->getTo() == to; });
-
-    if (it != outEdges.end()) {
-        (*it)->setType(type);
+    Edge* edge = getEdgeOut(to);
+    if (edge) {
+        edge->setType(type);
     }
 }
 
 void PolyNode::clearEdgeHighlights()
 {
-    for (auto& edge : outEdges) {
-        edge->setHighlight(false);
+    for (EdgeHandle handle : outEdges) {
+        mEdgeArena->get(handle)->setHighlight(false);
     }
 }
 
 // Position management
 void PolyNode::setPosition(float x, float y)
 {
-    mPosition.x = x;
-    mPosition.y = y;
+    setPosition(Vector2{x, y});
 }
 
 void PolyNode::setPosition(Vector2 position)
 {
-    mPosition = position;
+    if (mPosition.x != position.x || mPosition.y != position.y) {
+        mPosition = position;
+        markEdgesDirty();
+    }
 }
 
 Vector2 PolyNode::getPosition() const
@@ -240,40 +296,70 @@ void PolyNode::update(float dt)
         if ((direction > 0 && mScale >= mTargetScale) || (direction < 0 && mScale <= mTargetScale)) {
             mScale = mTargetScale;
         }
+
+        // The radius changed, so did the edge endpoints
+        markEdgesDirty();
     }
 }
 
-void PolyNode::draw()
+bool PolyNode::isResizing() const
 {
-    renderNodeShape();
-    renderText();
+    return mScale != mTargetScale;
 }
 
-// Helper methods
-void PolyNode::renderNodeShape()
+void PolyNode::drawLabels(RenderQueue& queue)
 {
-    float scaledRadius = mRadius * mScale;
-    DrawCircleV(mPosition, scaledRadius, mCurrentColor);
-    DrawCircleLines(mPosition.x, mPosition.y, scaledRadius, BLACK);
-}
+    const NodeStyle& style = NodeStyleTable::get(mStyle);
+
+    if (mDataDirty) {
+        mData.setText(mValue.toString(), style.font, style.fontSize, style.spacing);
+        mDataDirty = false;
+    }
 
-void PolyNode::renderText()
-{
     // Render data text in the center of the node
     if (!mData.empty()) {
-        Vector2 textSize = MeasureTextEx(mFont, mData.c_str(), mFontSize, 1);
+        Vector2 textSize = mData.getSize();
         Vector2 textPos  = {
             mPosition.x - textSize.x / 2,
             mPosition.y - textSize.y / 2};
-        DrawTextEx(mFont, mData.c_str(), textPos, mFontSize, 1, mTextColor);
+        mData.draw(queue, style.font, style.fontSize, style.spacing, textPos, style.textColor);
     }
 
     // Render label text below the node if it exists
     if (!mLabel.empty()) {
-        Vector2 labelSize = MeasureTextEx(mFont, mLabel.c_str(), mFontSize * 0.8f, 1);
+        Vector2 labelSize = mLabel.getSize();
         Vector2 labelPos  = {
             mPosition.x - labelSize.x / 2,
             mPosition.y + mRadius * mScale + 5};
-        DrawTextEx(mFont, mLabel.c_str(), labelPos, mFontSize * 0.8f, 1, mTextColor);
+        mLabel.draw(queue, style.font, style.labelFontSize, style.spacing, labelPos, style.textColor);
+    }
+}
+
+void PolyNode::markEdgesDirty()
+{
+    for (EdgeHandle handle : inEdges) {
+        mEdgeArena->get(handle)->markDirty();
+    }
+    for (EdgeHandle handle : outEdges) {
+        mEdgeArena->get(handle)->markDirty();
+    }
+}
+
+// Swap-and-pop removal from the edge lists, keeping back-pointers in sync
+void PolyNode::detachOut(uint32_t slot)
+{
+    if (slot + 1 < outEdges.size()) {
+        outEdges[slot] = outEdges.back();
+        mEdgeArena->get(outEdges[slot])->setOutSlot(slot);
+    }
+    outEdges.pop_back();
+}
+
+void PolyNode::detachIn(uint32_t slot)
+{
+    if (slot + 1 < inEdges.size()) {
+        inEdges[slot] = inEdges.back();
+        mEdgeArena->get(inEdges[slot])->setInSlot(slot);
     }
+    inEdges.pop_back();
 }
\ No newline at end of file
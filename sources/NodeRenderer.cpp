@@ -0,0 +1,127 @@
+#include "../includes/NodeRenderer.hpp"
+
+constexpr float NodeRenderer::LOD_RADIUS[];
+constexpr int NodeRenderer::LOD_SEGMENTS[];
+
+NodeRenderer::NodeRenderer()
+    : mPixelsPerUnit(1.0f), mNodeCount(0), mVertexCount(0)
+{
+}
+
+void NodeRenderer::begin(float pixelsPerUnit)
+{
+    for (auto& instances : mInstances) {
+        instances.clear();
+    }
+
+    mPixelsPerUnit = pixelsPerUnit;
+    mNodeCount     = 0;
+    mVertexCount   = 0;
+}
+
+void NodeRenderer::add(const PolyNode& node)
+{
+    float radius   = node.getRadius();
+    Vector2 center = node.getPosition();
+
+    mInstances[levelOf(radius)].push_back({center.x, center.y, radius, node.getFillColor(), node.getOutlineColor()});
+    mNodeCount++;
+}
+
+void NodeRenderer::flush(RenderQueue& queue)
+{
+    // All fills first, then all outlines, each as one vertex run
+    uint32_t fillVertices    = 0;
+    uint32_t outlineVertices = 0;
+    for (int level = 0; level < LOD_LEVELS; level++) {
+        uint32_t segments = static_cast<uint32_t>(mInstances[level].size() * LOD_SEGMENTS[level]);
+        fillVertices += segments * 3;
+        outlineVertices += segments * 2;
+    }
+    mVertexCount = static_cast<int>(fillVertices + outlineVertices);
+    if (mVertexCount == 0) {
+        return;
+    }
+
+    // Each run is filled before the next is recorded, recording may move them
+    RenderVertex* fills = queue.triangles(fillVertices);
+    for (int level = 0; level < LOD_LEVELS; level++) {
+        fills = writeFills(level, mInstances[level], fills);
+    }
+
+    RenderVertex* outlines = queue.lines(outlineVertices);
+    for (int level = 0; level < LOD_LEVELS; level++) {
+        outlines = writeOutlines(level, mInstances[level], outlines);
+    }
+}
+
+// Statistics
+int NodeRenderer::getNodeCount() const
+{
+    return mNodeCount;
+}
+
+int NodeRenderer::getVertexCount() const
+{
+    return mVertexCount;
+}
+
+// Helpers
+const std::vector<Vector2>& NodeRenderer::unitCircle(int level)
+{
+    // Built on first use, segments + 1 points so the last one closes the circle
+    static std::vector<Vector2> meshes[LOD_LEVELS];
+
+    std::vector<Vector2>& mesh = meshes[level];
+    if (mesh.empty()) {
+        int segments = LOD_SEGMENTS[level];
+        mesh.reserve(segments + 1);
+        for (int i = 0; i <= segments; i++) {
+            float angle = 2 * PI * i / segments;
+            mesh.push_back({cosf(angle), sinf(angle)});
+        }
+    }
+
+    return mesh;
+}
+
+int NodeRenderer::levelOf(float radius) const
+{
+    float pixels = radius * mPixelsPerUnit;
+
+    int level = 0;
+    while (level < LOD_LEVELS - 1 && pixels >= LOD_RADIUS[level]) {
+        level++;
+    }
+    return level;
+}
+
+RenderVertex* NodeRenderer::writeFills(int level, const std::vector<Instance>& instances, RenderVertex* out) const
+{
+    const std::vector<Vector2>& mesh = unitCircle(level);
+    int segments                     = LOD_SEGMENTS[level];
+
+    // Triangle fan per node, same winding as DrawCircleV
+    for (const Instance& node : instances) {
+        for (int s = 0; s < segments; s++) {
+            *out++ = {node.x, node.y, node.fill};
+            *out++ = {node.x + mesh[s + 1].x * node.radius, node.y + mesh[s + 1].y * node.radius, node.fill};
+            *out++ = {node.x + mesh[s].x * node.radius, node.y + mesh[s].y * node.radius, node.fill};
+        }
+    }
+    return out;
+}
+
+RenderVertex* NodeRenderer::writeOutlines(int level, const std::vector<Instance>& instances, RenderVertex* out) const
+{
+    const std::vector<Vector2>& mesh = unitCircle(level);
+    int segments                     = LOD_SEGMENTS[level];
+
+    for (const Instance& node : instances) {
+        for (int s = 0; s < segments; s++) {
+            *out++ = {node.x + mesh[s].x * node.radius, node.y + mesh[s].y * node.radius, node.outline};
+            *out++ = {node.x + mesh[s + 1].x * node.radius, node.y + mesh[s + 1].y * node.radius, node.outline};
+        }
+    }
+    return out;
+}
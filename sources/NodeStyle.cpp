@@ -0,0 +1,66 @@
+#include "../includes/NodeStyle.hpp"
+
+std::vector<NodeStyle> NodeStyleTable::sStyles;
+
+static bool sameColor(Color a, Color b)
+{
+    return a.r == b.r && a.g == b.g && a.b == b.b && a.a == b.a;
+}
+
+bool NodeStyle::operator==(const NodeStyle& other) const
+{
+    return font.texture.id == other.font.texture.id &&
+           fontSize == other.fontSize &&
+           labelFontSize == other.labelFontSize &&
+           spacing == other.spacing &&
+           sameColor(baseColor, other.baseColor) &&
+           sameColor(textColor, other.textColor) &&
+           sameColor(outlineColor, other.outlineColor) &&
+           sameColor(highlightPrimaryColor, other.highlightPrimaryColor) &&
+           sameColor(highlightSecondaryColor, other.highlightSecondaryColor);
+}
+
+// NodeStyleTable implementation
+
+uint16_t NodeStyleTable::intern(const NodeStyle& style)
+{
+    // Only a handful of styles exist, a linear scan beats hashing here
+    for (size_t i = 0; i < sStyles.size(); i++) {
+        if (sStyles[i] == style) {
+            return static_cast<uint16_t>(i);
+        }
+    }
+
+    // Table full, fall back to the first style
+    if (sStyles.size() >= MAX_STYLES) {
+        return 0;
+    }
+
+    sStyles.push_back(style);
+    return static_cast<uint16_t>(sStyles.size() - 1);
+}
+
+const NodeStyle& NodeStyleTable::get(uint16_t index)
+{
+    return sStyles[index];
+}
+
+size_t NodeStyleTable::size()
+{
+    return sStyles.size();
+}
+
+NodeStyle NodeStyleTable::makeDefault(Font font)
+{
+    NodeStyle style;
+    style.font                    = font;
+    style.fontSize                = 20.0f;
+    style.labelFontSize           = 20.0f * 0.8f;
+    style.spacing                 = 1.0f;
+    style.baseColor               = WHITE;
+    style.textColor               = BLACK;
+    style.outlineColor            = BLACK;
+    style.highlightPrimaryColor   = RED;
+    style.highlightSecondaryColor = BLUE;
+    return style;
+}
@@ -0,0 +1,243 @@
+#include "../includes/NodeValue.hpp"
+
+std::unordered_map<std::string, uint32_t> StringTable::sIds;
+std::deque<StringTable::Slot> StringTable::sSlots;
+std::vector<uint32_t> StringTable::sFree;
+
+// StringTable implementation
+
+uint32_t StringTable::intern(const std::string& text)
+{
+    auto it = sIds.find(text);
+    if (it != sIds.end()) {
+        sSlots[it->second].references++;
+        return it->second;
+    }
+
+    uint32_t id;
+    if (!sFree.empty()) {
+        id = sFree.back();
+        sFree.pop_back();
+        sSlots[id] = Slot{text, 1};
+    }
+    else {
+        id = static_cast<uint32_t>(sSlots.size());
+        sSlots.push_back(Slot{text, 1});
+    }
+    sIds.emplace(text, id);
+    return id;
+}
+
+void StringTable::retain(uint32_t id)
+{
+    sSlots[id].references++;
+}
+
+void StringTable::release(uint32_t id)
+{
+    Slot& slot = sSlots[id];
+    if (--slot.references > 0) {
+        return;
+    }
+
+    sIds.erase(slot.text);
+    std::string().swap(slot.text); // Gives the memory back, the slot is reused
+    sFree.push_back(id);
+}
+
+const std::string& StringTable::get(uint32_t id)
+{
+    return sSlots[id].text;
+}
+
+size_t StringTable::size()
+{
+    return sSlots.size() - sFree.size();
+}
+
+// NodeValue implementation
+// =========================================================
+
+NodeValue::NodeValue()
+    : mValue(std::monostate{})
+{
+}
+
+NodeValue::NodeValue(double value)
+    : mValue(value)
+{
+}
+
+NodeValue::NodeValue(const NodeValue& other)
+    : mValue(other.mValue)
+{
+    retain();
+}
+
+NodeValue::NodeValue(NodeValue&& other) noexcept
+    : mValue(other.mValue)
+{
+    other.mValue = std::monostate{};
+}
+
+NodeValue& NodeValue::operator=(const NodeValue& other)
+{
+    other.retain(); // Before the release, in case both hold the same string
+    release();
+    mValue = other.mValue;
+    return *this;
+}
+
+NodeValue& NodeValue::operator=(NodeValue&& other) noexcept
+{
+    if (this != &other) {
+        release();
+        mValue       = other.mValue;
+        other.mValue = std::monostate{};
+    }
+    return *this;
+}
+
+NodeValue::~NodeValue()
+{
+    release();
+}
+
+void NodeValue::retain() const
+{
+    if (getKind() == String) {
+        StringTable::retain(std::get<uint32_t>(mValue));
+    }
+}
+
+void NodeValue::release() const
+{
+    if (getKind() == String) {
+        StringTable::release(std::get<uint32_t>(mValue));
+    }
+}
+
+NodeValue NodeValue::fromString(const std::string& text)
+{
+    if (text.empty()) {
+        return NodeValue();
+    }
+
+    // Keep "42" numeric, but "042" or "4x" exactly as typed
+    char* end     = nullptr;
+    errno         = 0;
+    long long num = std::strtoll(text.c_str(), &end, 10);
+    if (errno == 0 && *end == '\0' && std::to_string(num) == text) {
+        return NodeValue(static_cast<int64_t>(num));
+    }
+
+    NodeValue value;
+    value.mValue = StringTable::intern(text);
+    return value;
+}
+
+NodeValue::Kind NodeValue::getKind() const
+{
+    return static_cast<Kind>(mValue.index());
+}
+
+bool NodeValue::empty() const
+{
+    return getKind() == Empty;
+}
+
+bool NodeValue::isNumber() const
+{
+    return getKind() == Integer || getKind() == Real;
+}
+
+int64_t NodeValue::asInt() const
+{
+    switch (getKind()) {
+        case Integer:
+            return std::get<int64_t>(mValue);
+        case Real:
+            return static_cast<int64_t>(std::get<double>(mValue));
+        case String: {
+            // Like std::stoi: leading whitespace and trailing text are fine
+            const char* text = StringTable::get(std::get<uint32_t>(mValue)).c_str();
+            errno            = 0;
+            long long num    = std::strtoll(text, nullptr, 10);
+            return errno == 0 ? num : 0;
+        }
+        default:
+            return 0;
+    }
+}
+
+double NodeValue::asReal() const
+{
+    switch (getKind()) {
+        case Integer:
+            return static_cast<double>(std::get<int64_t>(mValue));
+        case Real:
+            return std::get<double>(mValue);
+        case String: {
+            errno      = 0;
+            double num = std::strtod(StringTable::get(std::get<uint32_t>(mValue)).c_str(), nullptr);
+            return errno == 0 ? num : 0.0;
+        }
+        default:
+            return 0.0;
+    }
+}
+
+std::string NodeValue::toString() const
+{
+    switch (getKind()) {
+        case Integer:
+            return std::to_string(std::get<int64_t>(mValue));
+        case Real: {
+            // Shortest readable form, 2.5 rather than 2.500000
+            std::ostringstream stream;
+            stream << std::get<double>(mValue);
+            return stream.str();
+        }
+        case String:
+            return StringTable::get(std::get<uint32_t>(mValue));
+        default:
+            return "";
+    }
+}
+
+bool NodeValue::operator==(const NodeValue& other) const
+{
+    if (isNumber() && other.isNumber()) {
+        if (getKind() == Integer && other.getKind() == Integer) {
+            return asInt() == other.asInt();
+        }
+        return asReal() == other.asReal();
+    }
+    return mValue == other.mValue;
+}
+
+bool NodeValue::operator!=(const NodeValue& other) const
+{
+    return !(*this == other);
+}
+
+bool NodeValue::operator<(const NodeValue& other) const
+{
+    if (isNumber() && other.isNumber()) {
+        if (getKind() == Integer && other.getKind() == Integer) {
+            return asInt() < other.asInt();
+        }
+        return asReal() < other.asReal();
+    }
+
+    // Empty, then numbers, then strings in text order
+    int rank      = empty() ? 0 : (isNumber() ? 1 : 2);
+    int otherRank = other.empty() ? 0 : (other.isNumber() ? 1 : 2);
+    if (rank != otherRank) {
+        return rank < otherRank;
+    }
+    if (rank == 2) {
+        return StringTable::get(std::get<uint32_t>(mValue)) < StringTable::get(std::get<uint32_t>(other.mValue));
+    }
+    return false;
+}
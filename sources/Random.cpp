@@ -0,0 +1,135 @@
+#include "../includes/Random.hpp"
+
+uint64_t RandomService::sSeed = 0;
+
+static uint64_t splitMix64(uint64_t& x)
+{
+    uint64_t z = (x += 0x9E3779B97F4A7C15ull);
+    z          = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+    z          = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+    return z ^ (z >> 31);
+}
+
+static uint64_t rotl(uint64_t x, int k)
+{
+    return (x << k) | (x >> (64 - k));
+}
+
+// RandomStream implementation
+
+RandomStream::RandomStream()
+    : RandomStream(0, 0)
+{
+}
+
+RandomStream::RandomStream(uint64_t seed, uint64_t stream)
+{
+    // Mix the stream id in, then expand to the full state
+    uint64_t x = seed ^ splitMix64(stream);
+    for (uint64_t& word : mState) {
+        word = splitMix64(x);
+    }
+}
+
+uint64_t RandomStream::next()
+{
+    uint64_t result = rotl(mState[1] * 5, 7) * 9;
+    uint64_t t      = mState[1] << 17;
+
+    mState[2] ^= mState[0];
+    mState[3] ^= mState[1];
+    mState[1] ^= mState[2];
+    mState[0] ^= mState[3];
+    mState[2] ^= t;
+    mState[3] = rotl(mState[3], 45);
+
+    return result;
+}
+
+int RandomStream::nextInt(int min, int max)
+{
+    if (max <= min) {
+        return min;
+    }
+
+    // Reject the short tail so every value is equally likely
+    uint64_t range     = static_cast<uint64_t>(static_cast<int64_t>(max) - min) + 1;
+    uint64_t threshold = (0 - range) % range;
+    uint64_t r         = next();
+    while (r < threshold) {
+        r = next();
+    }
+    return static_cast<int>(min + static_cast<int64_t>(r % range));
+}
+
+float RandomStream::nextFloat(float min, float max)
+{
+    // Top 24 bits give every representable step in [0, 1)
+    float unit = static_cast<float>(next() >> 40) / static_cast<float>(1 << 24);
+    return min + (max - min) * unit;
+}
+
+// RandomService implementation
+// =========================================================
+
+void RandomService::init(int argc, char* argv[])
+{
+    uint64_t seed      = 0;
+    const char* source = nullptr;
+
+    size_t argumentLength = std::strlen(SEED_ARGUMENT);
+    for (int i = 1; i < argc && !source; i++) {
+        if (std::strcmp(argv[i], SEED_ARGUMENT) == 0 && i + 1 < argc && parseSeed(argv[i + 1], seed)) {
+            source = "command line";
+        }
+        else if (std::strncmp(argv[i], SEED_ARGUMENT, argumentLength) == 0 && argv[i][argumentLength] == '=' &&
+                 parseSeed(argv[i] + argumentLength + 1, seed)) {
+            source = "command line";
+        }
+    }
+
+    if (!source && parseSeed(std::getenv(SEED_VARIABLE), seed)) {
+        source = SEED_VARIABLE;
+    }
+
+    if (!source) {
+        seed   = static_cast<uint64_t>(time(nullptr));
+        source = "clock";
+    }
+
+    setSeed(seed);
+    // Logged so any run can be replayed with --seed
+    TraceLog(LOG_INFO, "RANDOM: Seed %llu (from %s)", static_cast<unsigned long long>(seed), source);
+}
+
+void RandomService::setSeed(uint64_t seed)
+{
+    sSeed = seed;
+}
+
+uint64_t RandomService::getSeed()
+{
+    return sSeed;
+}
+
+RandomStream RandomService::stream(Scene scene)
+{
+    return RandomStream(sSeed, static_cast<uint64_t>(scene));
+}
+
+bool RandomService::parseSeed(const char* text, uint64_t& seed)
+{
+    if (!text || *text == '\0') {
+        return false;
+    }
+
+    char* end                = nullptr;
+    errno                    = 0;
+    unsigned long long value = std::strtoull(text, &end, 10);
+    if (errno != 0 || *end != '\0') {
+        return false;
+    }
+
+    seed = static_cast<uint64_t>(value);
+    return true;
+}
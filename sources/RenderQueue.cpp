@@ -0,0 +1,412 @@
+#include "../includes/RenderQueue.hpp"
+#include "rlgl.h"
+
+namespace {
+    constexpr uint32_t BATCH_SHAPES  = 0;
+    constexpr uint32_t BATCH_TEXT    = 1;
+    constexpr uint32_t BATCH_TEXTURE = 2; // Plus the texture id
+    constexpr int INDEX_BITS         = 24;
+    constexpr uint64_t INDEX_MASK    = (1ull << INDEX_BITS) - 1;
+}
+
+RenderQueue::RenderQueue()
+    : mLayer(LAYER_SHAPES),
+      mCommandCount(0),
+      mBatchCount(0),
+      mUnsortedBatchCount(0)
+{
+}
+
+void RenderQueue::setLayer(uint8_t layer)
+{
+    mLayer = layer;
+}
+
+uint8_t RenderQueue::getLayer() const
+{
+    return mLayer;
+}
+
+void RenderQueue::beginWorld(const Camera2D& camera)
+{
+    mPasses.push_back(RenderPass{static_cast<uint32_t>(mCommands.size()), 0, true, camera});
+}
+
+void RenderQueue::endWorld()
+{
+    mPasses.push_back(RenderPass{static_cast<uint32_t>(mCommands.size()), 0, false, Camera2D{}});
+}
+
+void RenderQueue::rectangle(Rectangle rect, Color color)
+{
+    RenderCommand& command = push(DrawOp::Rectangle, color);
+    command.p[0]           = rect.x;
+    command.p[1]           = rect.y;
+    command.p[2]           = rect.width;
+    command.p[3]           = rect.height;
+}
+
+void RenderQueue::rectangleLines(Rectangle rect, float thickness, Color color)
+{
+    RenderCommand& command = push(DrawOp::RectangleLines, color);
+    command.p[0]           = rect.x;
+    command.p[1]           = rect.y;
+    command.p[2]           = rect.width;
+    command.p[3]           = rect.height;
+    command.p[4]           = thickness;
+}
+
+void RenderQueue::circle(Vector2 center, float radius, Color color)
+{
+    RenderCommand& command = push(DrawOp::Circle, color);
+    command.p[0]           = center.x;
+    command.p[1]           = center.y;
+    command.p[2]           = radius;
+}
+
+void RenderQueue::line(Vector2 start, Vector2 end, float thickness, Color color)
+{
+    RenderCommand& command = push(DrawOp::Line, color);
+    command.p[0]           = start.x;
+    command.p[1]           = start.y;
+    command.p[2]           = end.x;
+    command.p[3]           = end.y;
+    command.p[4]           = thickness;
+}
+
+void RenderQueue::triangle(Vector2 a, Vector2 b, Vector2 c, Color color)
+{
+    RenderCommand& command = push(DrawOp::Triangle, color);
+    command.p[0]           = a.x;
+    command.p[1]           = a.y;
+    command.p[2]           = b.x;
+    command.p[3]           = b.y;
+    command.p[4]           = c.x;
+    command.p[5]           = c.y;
+}
+
+void RenderQueue::text(const char* text, int x, int y, int size, Color color)
+{
+    if (text == nullptr || text[0] == '\0')
+        return;
+
+    // Copied, callers often pass TextFormat's rotating buffers
+    RenderCommand& command = push(DrawOp::Text, color);
+    command.p[0]           = static_cast<float>(x);
+    command.p[1]           = static_cast<float>(y);
+    command.p[2]           = static_cast<float>(size);
+    command.payload        = static_cast<uint32_t>(mText.size());
+    mText.insert(mText.end(), text, text + strlen(text) + 1);
+}
+
+void RenderQueue::texture(Texture2D texture, Rectangle source, Rectangle dest, Color color, float rotation)
+{
+    RenderCommand& command = push(DrawOp::Texture, color);
+    command.p[0]           = dest.x;
+    command.p[1]           = dest.y;
+    command.p[2]           = dest.width;
+    command.p[3]           = dest.height;
+    command.p[4]           = rotation;
+    command.payload        = static_cast<uint32_t>(mTextures.size());
+    mTextures.push_back(TextureSlot{texture, source});
+}
+
+RenderVertex* RenderQueue::triangles(uint32_t count)
+{
+    return pushVertices(DrawOp::Triangles, count);
+}
+
+RenderVertex* RenderQueue::lines(uint32_t count)
+{
+    return pushVertices(DrawOp::Lines, count);
+}
+
+void RenderQueue::glyphs(Font font, const int* codepoints, int count, Vector2 position, float size, float spacing, Color color)
+{
+    if (count <= 0)
+        return;
+
+    RenderCommand& command = push(DrawOp::Glyphs, color);
+    command.p[0]           = position.x;
+    command.p[1]           = position.y;
+    command.p[2]           = size;
+    command.p[3]           = spacing;
+    command.payload        = static_cast<uint32_t>(mRuns.size());
+    mRuns.push_back(RenderRun{static_cast<uint32_t>(mCodepoints.size()), static_cast<uint32_t>(count), font});
+    mCodepoints.insert(mCodepoints.end(), codepoints, codepoints + count);
+}
+
+RenderVertex* RenderQueue::pushVertices(DrawOp op, uint32_t count)
+{
+    // Vertices carry their own colour
+    RenderCommand& command = push(op, WHITE);
+    command.payload        = static_cast<uint32_t>(mRuns.size());
+    mRuns.push_back(RenderRun{static_cast<uint32_t>(mVertices.size()), count, Font{}});
+    mVertices.resize(mVertices.size() + count);
+    return mVertices.data() + mVertices.size() - count;
+}
+
+RenderCommand& RenderQueue::push(DrawOp op, Color color)
+{
+    if (mPasses.empty())
+        endWorld(); // Opens the first screen pass
+
+    mPasses.back().count++;
+    mCommands.push_back(RenderCommand{op, mLayer, color, {0, 0, 0, 0, 0, 0}, 0});
+    return mCommands.back();
+}
+
+uint32_t RenderQueue::batchOf(const RenderCommand& command) const
+{
+    switch (command.op) {
+        case DrawOp::Text:
+            return BATCH_TEXT;
+        case DrawOp::Texture:
+            return BATCH_TEXTURE + mTextures[command.payload].texture.id;
+        case DrawOp::Glyphs:
+            return BATCH_TEXTURE + mRuns[command.payload].font.texture.id;
+        default:
+            return BATCH_SHAPES;
+    }
+}
+
+void RenderQueue::flush(RenderBackend& backend)
+{
+    // Layer first, then batch state, then recorded order to keep it stable
+    mOrder.resize(mCommands.size());
+    mKeys.resize(mCommands.size());
+    for (const RenderPass& pass : mPasses) {
+        for (uint32_t i = pass.first; i < pass.first + pass.count; i++) {
+            const RenderCommand& command = mCommands[i];
+            mKeys[i] = (static_cast<uint64_t>(command.layer) << 56) |
+                       (static_cast<uint64_t>(batchOf(command)) << INDEX_BITS) |
+                       (i & INDEX_MASK);
+        }
+        std::sort(mKeys.begin() + pass.first, mKeys.begin() + pass.first + pass.count);
+        for (uint32_t i = pass.first; i < pass.first + pass.count; i++)
+            mOrder[i] = static_cast<uint32_t>(mKeys[i] & INDEX_MASK);
+    }
+
+    mCommandCount       = static_cast<int>(mCommands.size());
+    mBatchCount         = countBatches(true);
+    mUnsortedBatchCount = countBatches(false);
+
+    backend.submit(*this);
+    clear();
+}
+
+int RenderQueue::countBatches(bool sorted) const
+{
+    // Every pass starts a new batch, camera changes flush raylib's
+    int batches = 0;
+    for (const RenderPass& pass : mPasses) {
+        uint32_t previous = UINT32_MAX;
+        for (uint32_t i = pass.first; i < pass.first + pass.count; i++) {
+            uint32_t batch = batchOf(mCommands[sorted ? mOrder[i] : i]);
+            if (batch != previous)
+                batches++;
+            previous = batch;
+        }
+    }
+    return batches;
+}
+
+void RenderQueue::clear()
+{
+    mCommands.clear();
+    mPasses.clear();
+    mText.clear();
+    mTextures.clear();
+    mRuns.clear();
+    mVertices.clear();
+    mCodepoints.clear();
+    mLayer = LAYER_SHAPES;
+}
+
+const std::vector<RenderPass>& RenderQueue::getPasses() const
+{
+    return mPasses;
+}
+
+const std::vector<uint32_t>& RenderQueue::getOrder() const
+{
+    return mOrder;
+}
+
+const RenderCommand& RenderQueue::getCommand(uint32_t index) const
+{
+    return mCommands[index];
+}
+
+const char* RenderQueue::getText(uint32_t offset) const
+{
+    return mText.data() + offset;
+}
+
+const TextureSlot& RenderQueue::getTexture(uint32_t slot) const
+{
+    return mTextures[slot];
+}
+
+const RenderRun& RenderQueue::getRun(uint32_t run) const
+{
+    return mRuns[run];
+}
+
+const RenderVertex* RenderQueue::getVertices(const RenderRun& run) const
+{
+    return mVertices.data() + run.first;
+}
+
+const int* RenderQueue::getCodepoints(const RenderRun& run) const
+{
+    return mCodepoints.data() + run.first;
+}
+
+int RenderQueue::getCommandCount() const
+{
+    return mCommandCount;
+}
+
+int RenderQueue::getBatchCount() const
+{
+    return mBatchCount;
+}
+
+int RenderQueue::getUnsortedBatchCount() const
+{
+    return mUnsortedBatchCount;
+}
+
+// =========================================================
+
+void RaylibBackend::submit(const RenderQueue& queue)
+{
+    const std::vector<uint32_t>& order = queue.getOrder();
+    for (const RenderPass& pass : queue.getPasses()) {
+        if (pass.count == 0)
+            continue;
+        if (pass.world)
+            BeginMode2D(pass.camera);
+
+        for (uint32_t i = pass.first; i < pass.first + pass.count; i++) {
+            const RenderCommand& c = queue.getCommand(order[i]);
+            switch (c.op) {
+                case DrawOp::Rectangle:
+                    DrawRectangleRec(Rectangle{c.p[0], c.p[1], c.p[2], c.p[3]}, c.color);
+                    break;
+                case DrawOp::RectangleLines:
+                    DrawRectangleLinesEx(Rectangle{c.p[0], c.p[1], c.p[2], c.p[3]}, c.p[4], c.color);
+                    break;
+                case DrawOp::Circle:
+                    DrawCircleV(Vector2{c.p[0], c.p[1]}, c.p[2], c.color);
+                    break;
+                case DrawOp::Line:
+                    DrawLineEx(Vector2{c.p[0], c.p[1]}, Vector2{c.p[2], c.p[3]}, c.p[4], c.color);
+                    break;
+                case DrawOp::Triangle:
+                    DrawTriangle(Vector2{c.p[0], c.p[1]}, Vector2{c.p[2], c.p[3]}, Vector2{c.p[4], c.p[5]}, c.color);
+                    break;
+                case DrawOp::Text:
+                    DrawText(queue.getText(c.payload), static_cast<int>(c.p[0]), static_cast<int>(c.p[1]),
+                             static_cast<int>(c.p[2]), c.color);
+                    break;
+                case DrawOp::Texture: {
+                    const TextureSlot& slot = queue.getTexture(c.payload);
+                    DrawTexturePro(slot.texture, slot.source, Rectangle{c.p[0], c.p[1], c.p[2], c.p[3]},
+                                   Vector2{0, 0}, c.p[4], c.color);
+                    break;
+                }
+                case DrawOp::Triangles:
+                case DrawOp::Lines: {
+                    const RenderRun& run = queue.getRun(c.payload);
+                    drawVertices(c.op == DrawOp::Triangles ? RL_TRIANGLES : RL_LINES, queue.getVertices(run), run.count);
+                    break;
+                }
+                case DrawOp::Glyphs: {
+                    const RenderRun& run = queue.getRun(c.payload);
+                    DrawTextCodepoints(run.font, queue.getCodepoints(run), static_cast<int>(run.count),
+                                       Vector2{c.p[0], c.p[1]}, c.p[2], c.p[3], c.color);
+                    break;
+                }
+            }
+        }
+
+        if (pass.world)
+            EndMode2D();
+    }
+}
+
+void RaylibBackend::drawVertices(int mode, const RenderVertex* vertices, uint32_t count)
+{
+    // Chunks are whole triangles and lines, rlgl flushes its batch when one wouldn't fit
+    for (uint32_t first = 0; first < count; first += CHUNK_VERTICES) {
+        uint32_t last = std::min(count, first + CHUNK_VERTICES);
+        rlCheckRenderBatchLimit(static_cast<int>(last - first));
+
+        rlBegin(mode);
+        for (uint32_t i = first; i < last; i++) {
+            const RenderVertex& vertex = vertices[i];
+            rlColor4ub(vertex.color.r, vertex.color.g, vertex.color.b, vertex.color.a);
+            rlVertex2f(vertex.x, vertex.y);
+        }
+        rlEnd();
+    }
+}
+
+// =========================================================
+
+NullBackend::NullBackend()
+{
+    reset();
+}
+
+void NullBackend::submit(const RenderQueue& queue)
+{
+    const std::vector<uint32_t>& order = queue.getOrder();
+    for (const RenderPass& pass : queue.getPasses()) {
+        for (uint32_t i = pass.first; i < pass.first + pass.count; i++) {
+            const RenderCommand& command = queue.getCommand(order[i]);
+            mCommandsByOp[static_cast<int>(command.op)]++;
+            if (command.op == DrawOp::Triangles || command.op == DrawOp::Lines)
+                mVertices += queue.getRun(command.payload).count;
+        }
+    }
+    mCommands += queue.getCommandCount();
+    mBatches += queue.getBatchCount();
+    mFrames++;
+}
+
+void NullBackend::reset()
+{
+    mFrames   = 0;
+    mCommands = 0;
+    mBatches  = 0;
+    mVertices = 0;
+    std::fill(std::begin(mCommandsByOp), std::end(mCommandsByOp), 0);
+}
+
+int NullBackend::getFrames() const
+{
+    return mFrames;
+}
+
+long long NullBackend::getCommands() const
+{
+    return mCommands;
+}
+
+long long NullBackend::getCommands(DrawOp op) const
+{
+    return mCommandsByOp[static_cast<int>(op)];
+}
+
+long long NullBackend::getBatches() const
+{
+    return mBatches;
+}
+
+long long NullBackend::getVertices() const
+{
+    return mVertices;
+}
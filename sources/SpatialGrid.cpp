@@ -0,0 +1,224 @@
+#include "../includes/SpatialGrid.hpp"
+
+SpatialGrid::SpatialGrid(float cellSize)
+    : mCellSize(cellSize), mQueryStamp(0)
+{
+}
+
+void SpatialGrid::setCellSize(float cellSize)
+{
+    if (cellSize == mCellSize) {
+        return;
+    }
+
+    // Re-bucket every item with the new cell size
+    mCellSize = cellSize;
+    mCells.clear();
+    for (int id = 0; id < static_cast<int>(mItems.size()); id++) {
+        if (mItems[id].active) {
+            mItems[id].cells = cellRange(mItems[id].bounds);
+            link(id, mItems[id].cells);
+        }
+    }
+}
+
+float SpatialGrid::getCellSize() const
+{
+    return mCellSize;
+}
+
+// Item management
+void SpatialGrid::insert(int id, Rectangle bounds)
+{
+    if (id < 0) {
+        return;
+    }
+
+    if (id >= static_cast<int>(mItems.size())) {
+        mItems.resize(id + 1, Item{{0, 0, 0, 0}, {0, 0, -1, -1}, false});
+        mStamps.resize(id + 1, 0);
+    }
+
+    if (mItems[id].active) {
+        update(id, bounds);
+        return;
+    }
+
+    mItems[id] = {bounds, cellRange(bounds), true};
+    link(id, mItems[id].cells);
+}
+
+void SpatialGrid::update(int id, Rectangle bounds)
+{
+    if (!contains(id)) {
+        insert(id, bounds);
+        return;
+    }
+
+    Item& item      = mItems[id];
+    CellRange cells = cellRange(bounds);
+    item.bounds     = bounds;
+
+    // Still covering the same cells, nothing to move
+    if (cells == item.cells) {
+        return;
+    }
+
+    unlink(id, item.cells);
+    item.cells = cells;
+    link(id, item.cells);
+}
+
+void SpatialGrid::remove(int id)
+{
+    if (!contains(id)) {
+        return;
+    }
+
+    unlink(id, mItems[id].cells);
+    mItems[id].active = false;
+}
+
+void SpatialGrid::clear()
+{
+    mCells.clear();
+    mItems.clear();
+    mStamps.clear();
+}
+
+bool SpatialGrid::contains(int id) const
+{
+    return id >= 0 && id < static_cast<int>(mItems.size()) && mItems[id].active;
+}
+
+Rectangle SpatialGrid::getBounds(int id) const
+{
+    return contains(id) ? mItems[id].bounds : Rectangle{0, 0, 0, 0};
+}
+
+// Queries
+void SpatialGrid::queryPoint(Vector2 point, std::vector<int>& result) const
+{
+    auto it = mCells.find(cellKey(static_cast<int>(floorf(point.x / mCellSize)),
+                                  static_cast<int>(floorf(point.y / mCellSize))));
+    if (it == mCells.end()) {
+        return;
+    }
+
+    for (int id : it->second) {
+        if (CheckCollisionPointRec(point, mItems[id].bounds)) {
+            result.push_back(id);
+        }
+    }
+}
+
+void SpatialGrid::queryRadius(Vector2 center, float radius, std::vector<int>& result) const
+{
+    size_t first = result.size();
+    queryRect(circleBounds(center, radius), result);
+
+    // Keep boxes that actually reach the circle
+    auto outside = [&](int id) {
+        const Rectangle& box = mItems[id].bounds;
+        float dx             = center.x - Clamp(center.x, box.x, box.x + box.width);
+        float dy             = center.y - Clamp(center.y, box.y, box.y + box.height);
+        return dx * dx + dy * dy > radius * radius;
+    };
+    result.erase(std::remove_if(result.begin() + first, result.end(), outside), result.end());
+}
+
+void SpatialGrid::queryRect(Rectangle area, std::vector<int>& result) const
+{
+    CellRange cells = cellRange(area);
+    mQueryStamp++;
+
+    // Large areas cover more cells than are occupied, walk the occupied ones instead
+    int64_t cellCount = static_cast<int64_t>(cells.maxX - cells.minX + 1) * (cells.maxY - cells.minY + 1);
+    if (cellCount > static_cast<int64_t>(mCells.size())) {
+        for (const auto& cell : mCells) {
+            for (int id : cell.second) {
+                if (mStamps[id] == mQueryStamp) {
+                    continue;
+                }
+                mStamps[id] = mQueryStamp;
+
+                if (CheckCollisionRecs(area, mItems[id].bounds)) {
+                    result.push_back(id);
+                }
+            }
+        }
+        return;
+    }
+
+    for (int y = cells.minY; y <= cells.maxY; y++) {
+        for (int x = cells.minX; x <= cells.maxX; x++) {
+            auto it = mCells.find(cellKey(x, y));
+            if (it == mCells.end()) {
+                continue;
+            }
+
+            for (int id : it->second) {
+                if (mStamps[id] == mQueryStamp) {
+                    continue;
+                }
+                mStamps[id] = mQueryStamp;
+
+                if (CheckCollisionRecs(area, mItems[id].bounds)) {
+                    result.push_back(id);
+                }
+            }
+        }
+    }
+}
+
+Rectangle SpatialGrid::circleBounds(Vector2 center, float radius)
+{
+    return Rectangle{center.x - radius, center.y - radius, radius * 2, radius * 2};
+}
+
+// Helpers
+SpatialGrid::CellRange SpatialGrid::cellRange(Rectangle bounds) const
+{
+    return CellRange{
+        static_cast<int>(floorf(bounds.x / mCellSize)),
+        static_cast<int>(floorf(bounds.y / mCellSize)),
+        static_cast<int>(floorf((bounds.x + bounds.width) / mCellSize)),
+        static_cast<int>(floorf((bounds.y + bounds.height) / mCellSize))};
+}
+
+uint64_t SpatialGrid::cellKey(int x, int y)
+{
+    return (static_cast<uint64_t>(static_cast<uint32_t>(x)) << 32) | static_cast<uint32_t>(y);
+}
+
+void SpatialGrid::link(int id, const CellRange& cells)
+{
+    for (int y = cells.minY; y <= cells.maxY; y++) {
+        for (int x = cells.minX; x <= cells.maxX; x++) {
+            mCells[cellKey(x, y)].push_back(id);
+        }
+    }
+}
+
+void SpatialGrid::unlink(int id, const CellRange& cells)
+{
+    for (int y = cells.minY; y <= cells.maxY; y++) {
+        for (int x = cells.minX; x <= cells.maxX; x++) {
+            auto it = mCells.find(cellKey(x, y));
+            if (it == mCells.end()) {
+                continue;
+            }
+
+            // Swap-and-pop, cells are unordered
+            std::vector<int>& bucket = it->second;
+            auto found               = std::find(bucket.begin(), bucket.end(), id);
+            if (found != bucket.end()) {
+                *found = bucket.back();
+                bucket.pop_back();
+            }
+            if (bucket.empty()) {
+                mCells.erase(it);
+            }
+        }
+    }
+}
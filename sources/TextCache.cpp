@@ -0,0 +1,153 @@
+#include "../includes/TextCache.hpp"
+
+std::list<TextCache::Extent> TextCache::sRecent;
+std::unordered_map<std::string, std::list<TextCache::Extent>::iterator> TextCache::sExtents;
+
+// TextCache implementation
+
+Vector2 TextCache::measure(Font font, const std::string& text, float fontSize, float spacing)
+{
+    // Key: font texture, size and spacing bits, then the text itself
+    std::string key(sizeof(unsigned int) + sizeof(float) * 2, '\0');
+    std::memcpy(&key[0], &font.texture.id, sizeof(unsigned int));
+    std::memcpy(&key[sizeof(unsigned int)], &fontSize, sizeof(float));
+    std::memcpy(&key[sizeof(unsigned int) + sizeof(float)], &spacing, sizeof(float));
+    key += text;
+
+    auto it = sExtents.find(key);
+    if (it != sExtents.end()) {
+        sRecent.splice(sRecent.begin(), sRecent, it->second);
+        return it->second->size;
+    }
+
+    if (sExtents.size() >= CAPACITY) {
+        sExtents.erase(sRecent.back().key);
+        sRecent.pop_back();
+    }
+
+    Vector2 extent = MeasureTextEx(font, text.c_str(), fontSize, spacing);
+    sRecent.push_front(Extent{key, extent});
+    sExtents.emplace(std::move(key), sRecent.begin());
+    return extent;
+}
+
+void TextCache::clear()
+{
+    sExtents.clear();
+    sRecent.clear();
+}
+
+size_t TextCache::size()
+{
+    return sExtents.size();
+}
+
+// TextRun implementation
+// =========================================================
+
+TextRun::TextRun()
+    : mSize({0, 0})
+{
+}
+
+void TextRun::setText(const std::string& text, Font font, float fontSize, float spacing)
+{
+    if (text == mText) {
+        return;
+    }
+
+    mText = text;
+    mCodepoints.clear();
+    if (mText.empty()) {
+        mSize = {0, 0};
+        return;
+    }
+
+    // Decode once, drawing then skips UTF-8 parsing
+    int count       = 0;
+    int* codepoints = LoadCodepoints(mText.c_str(), &count);
+    mCodepoints.assign(codepoints, codepoints + count);
+    UnloadCodepoints(codepoints);
+
+    remeasure(font, fontSize, spacing);
+}
+
+void TextRun::remeasure(Font font, float fontSize, float spacing)
+{
+    mSize = mText.empty() ? Vector2{0, 0} : TextCache::measure(font, mText, fontSize, spacing);
+}
+
+const std::string& TextRun::getText() const
+{
+    return mText;
+}
+
+bool TextRun::empty() const
+{
+    return mText.empty();
+}
+
+Vector2 TextRun::getSize() const
+{
+    return mSize;
+}
+
+void TextRun::draw(RenderQueue& queue, Font font, float fontSize, float spacing, Vector2 position, Color color) const
+{
+    queue.glyphs(font, mCodepoints.data(), static_cast<int>(mCodepoints.size()), position, fontSize, spacing, color);
+}
+
+// TextLayout implementation
+// =========================================================
+
+TextLayout::TextLayout()
+    : mFont(GetFontDefault()), mFontSize(20.0f), mSpacing(1.0f)
+{
+}
+
+TextLayout::TextLayout(Font font, float fontSize, float spacing)
+    : mFont(font), mFontSize(fontSize), mSpacing(spacing)
+{
+}
+
+void TextLayout::setText(const std::string& text)
+{
+    mRun.setText(text, mFont, mFontSize, mSpacing);
+}
+
+void TextLayout::setFont(Font font, float fontSize, float spacing)
+{
+    if (font.texture.id == mFont.texture.id && fontSize == mFontSize && spacing == mSpacing) {
+        return;
+    }
+
+    mFont     = font;
+    mFontSize = fontSize;
+    mSpacing  = spacing;
+    mRun.remeasure(mFont, mFontSize, mSpacing);
+}
+
+const std::string& TextLayout::getText() const
+{
+    return mRun.getText();
+}
+
+bool TextLayout::empty() const
+{
+    return mRun.empty();
+}
+
+Vector2 TextLayout::getSize() const
+{
+    return mRun.getSize();
+}
+
+float TextLayout::getFontSize() const
+{
+    return mFontSize;
+}
+
+void TextLayout::draw(RenderQueue& queue, Vector2 position, Color color) const
+{
+    mRun.draw(queue, mFont, mFontSize, mSpacing, position, color);
+}
\ No newline at end of file
@@ -0,0 +1,109 @@
+#include "../includes/Tween.hpp"
+
+// TweenPool implementation
+
+TweenPool::TweenPool()
+{
+}
+
+void TweenPool::reserve(size_t tracks)
+{
+    mTargets.reserve(tracks);
+    mFrom.reserve(tracks);
+    mDelta.reserve(tracks);
+    mEase.reserve(tracks);
+    mValues.reserve(tracks);
+}
+
+void TweenPool::clear()
+{
+    mTargets.clear();
+    mFrom.clear();
+    mDelta.clear();
+    mEase.clear();
+    mValues.clear();
+}
+
+size_t TweenPool::size() const
+{
+    return mFrom.size();
+}
+
+uint32_t TweenPool::add(float* target, float from, float to, Ease ease)
+{
+    uint32_t track = static_cast<uint32_t>(mFrom.size());
+    mTargets.push_back(target);
+    mFrom.push_back(from);
+    mDelta.push_back(to - from);
+    mEase.push_back(static_cast<uint8_t>(ease));
+    mValues.push_back(from);
+    return track;
+}
+
+uint32_t TweenPool::add(Vector2* target, Vector2 from, Vector2 to, Ease ease)
+{
+    uint32_t track = add(target ? &target->x : nullptr, from.x, to.x, ease);
+    add(target ? &target->y : nullptr, from.y, to.y, ease);
+    return track;
+}
+
+void TweenPool::evaluate(uint32_t first, uint32_t count, float progress)
+{
+    uint32_t last = std::min<uint32_t>(first + count, static_cast<uint32_t>(mFrom.size()));
+    if (first >= last) {
+        return;
+    }
+
+    // Every easing curve once per call, tracks then only look their factor up
+    float eased[static_cast<int>(Ease::Count)];
+    for (int i = 0; i < static_cast<int>(Ease::Count); i++) {
+        eased[i] = ease(static_cast<Ease>(i), progress);
+    }
+
+    const float* from    = mFrom.data();
+    const float* delta   = mDelta.data();
+    const uint8_t* kinds = mEase.data();
+    float* values        = mValues.data();
+    for (uint32_t i = first; i < last; i++) {
+        values[i] = from[i] + delta[i] * eased[kinds[i]];
+    }
+
+    // Scatter to the targets in a second pass, keeping the loop above branch-free
+    float* const* targets = mTargets.data();
+    for (uint32_t i = first; i < last; i++) {
+        if (targets[i]) {
+            *targets[i] = values[i];
+        }
+    }
+}
+
+float TweenPool::getValue(uint32_t track) const
+{
+    return mValues[track];
+}
+
+float TweenPool::ease(Ease ease, float t)
+{
+    t = std::min(1.0f, std::max(0.0f, t));
+    switch (ease) {
+        case Ease::InQuad:
+            return t * t;
+        case Ease::OutQuad:
+            return t * (2.0f - t);
+        case Ease::InOutQuad:
+            return t < 0.5f ? 2.0f * t * t : -1.0f + (4.0f - 2.0f * t) * t;
+        case Ease::OutCubic: {
+            float u = t - 1.0f;
+            return u * u * u + 1.0f;
+        }
+        case Ease::InOutCubic: {
+            if (t < 0.5f) {
+                return 4.0f * t * t * t;
+            }
+            float u = 2.0f * t - 2.0f;
+            return 0.5f * u * u * u + 1.0f;
+        }
+        default:
+            return t;
+    }
+}
@@ -2,6 +2,7 @@
 #include "../includes/UI.hpp"
 #include "../includes/Button.hpp"
 #include "../includes/Utility.hpp"
+#include "../includes/FrameExporter.hpp"
 
 #include "../includes/AVLTree.hpp"
 #include "../includes/Graph.hpp"
@@ -72,7 +73,7 @@ void ReturnButtonComponent::setFontSize(int newSize)
 
 // =========================================================
 
-Camera2DComponent::Camera2DComponent() : isPanning(false), minZoom(0.1f), maxZoom(5.0f)
+Camera2DComponent::Camera2DComponent() : isPanning(false), minZoom(0.1f), maxZoom(5.0f), changed(false)
 {
     resetCamera();
 }
@@ -84,6 +85,8 @@ void Camera2DComponent::init()
 
 void Camera2DComponent::update()
 {
+    Camera2D before = camera;
+
     // Zoom with mouse wheel
     float wheel = GetMouseWheelMove();
     if (wheel != 0) {
@@ -128,6 +131,10 @@ void Camera2DComponent::update()
     if (IsKeyPressed(KEY_R)) {
         resetCamera();
     }
+
+    changed = before.target.x != camera.target.x || before.target.y != camera.target.y ||
+              before.offset.x != camera.offset.x || before.offset.y != camera.offset.y ||
+              before.zoom != camera.zoom || before.rotation != camera.rotation;
 }
 
 void Camera2DComponent::draw()
@@ -145,6 +152,11 @@ void Camera2DComponent::endMode()
     EndMode2D();
 }
 
+bool Camera2DComponent::hasChanged() const
+{
+    return changed;
+}
+
 void Camera2DComponent::handleWindowResize()
 {
     // Update offset on window resize to keep center point
@@ -178,6 +190,37 @@ Vector2 Camera2DComponent::worldToScreen(Vector2 position)
     return GetWorldToScreen2D(position, camera);
 }
 
+float Camera2DComponent::getZoom() const
+{
+    return camera.zoom;
+}
+
+const Camera2D& Camera2DComponent::getCamera() const
+{
+    return camera;
+}
+
+Rectangle Camera2DComponent::getWorldRect()
+{
+    // Bounding box of the four screen corners, also correct for a rotated camera
+    float width        = static_cast<float>(GetScreenWidth());
+    float height       = static_cast<float>(GetScreenHeight());
+    Vector2 corners[4] = {
+        screenToWorld({0, 0}),
+        screenToWorld({width, 0}),
+        screenToWorld({0, height}),
+        screenToWorld({width, height})};
+
+    Vector2 min = corners[0];
+    Vector2 max = corners[0];
+    for (const Vector2& corner : corners) {
+        min = {fminf(min.x, corner.x), fminf(min.y, corner.y)};
+        max = {fmaxf(max.x, corner.x), fmaxf(max.y, corner.y)};
+    }
+
+    return Rectangle{min.x, min.y, max.x - min.x, max.y - min.y};
+}
+
 // =========================================================
 
 SceneManager::SceneManager()
@@ -205,10 +248,24 @@ void SceneManager::updateComponents()
         components[i]->update();
         if (Application::getInstance()->getCurScene() != this)
             break;
+        if (components[i]->hasChanged())
+            markDirty();
         ++i;
     }
 }
 
+void SceneManager::markDirty()
+{
+    dirty = true;
+}
+
+bool SceneManager::takeDirty()
+{
+    bool redraw = dirty || isAnimating();
+    dirty       = false;
+    return redraw;
+}
+
 void SceneManager::drawComponents()
 {
     for (auto& component : components) {
@@ -240,11 +297,29 @@ void SceneManager::cleanComponents()
 
 void Title::init()
 {
-    background = LoadTexture("images/a_ship_in_the_water.jpg");
+    // Drawn without the background until it's decoded, the first frame doesn't wait
+    backgroundReady = Application::getInstance()->getAssets().tryAcquire(BACKGROUND_PATH, background);
+    pulseStart      = GetTime();
+    pulsing         = true;
 }
 
 void Title::update()
 {
+    if (!backgroundReady && Application::getInstance()->getAssets().tryAcquire(BACKGROUND_PATH, background)) {
+        backgroundReady = true;
+        markDirty();
+    }
+
+    // A pulse that never ends would keep the app from ever idling; the last
+    // frame of it is drawn at full alpha
+    Vector2 mouseDelta = GetMouseDelta();
+    if (mouseDelta.x != 0 || mouseDelta.y != 0)
+        pulseStart = GetTime();
+    bool wasPulsing = pulsing;
+    pulsing         = GetTime() - pulseStart < PULSE_CYCLES * PI;
+    if (wasPulsing && !pulsing)
+        markDirty();
+
     if (IsWindowResized())
         updateFontSize();
 
@@ -258,23 +333,41 @@ void Title::update()
 
 void Title::draw()
 {
-    float scale = fmaxf((float)GetScreenWidth() / background.width, (float)GetScreenHeight() / background.height);
-    DrawTextureEx(background, Vector2{0, 0}, 0, scale, WHITE);
+    RenderQueue& queue = Application::getInstance()->getRenderQueue();
+
+    queue.setLayer(RenderQueue::LAYER_BACKGROUND);
+    if (background.id != 0) {
+        float scale = fmaxf((float)GetScreenWidth() / background.width, (float)GetScreenHeight() / background.height);
+        queue.texture(background, Rectangle{0, 0, (float)background.width, (float)background.height},
+                      Rectangle{0, 0, background.width * scale, background.height * scale}, WHITE);
+    }
+    else {
+        queue.rectangle(Rectangle{0, 0, (float)GetScreenWidth(), (float)GetScreenHeight()}, DARKGRAY);
+    }
 
-    float elapsedTime = static_cast<float>(GetTime());
-    float alpha       = 0.7f + 0.3f * sinf(elapsedTime * 2.0f);
+    // Starts and ends at full alpha, a cycle every PI seconds
+    float elapsedTime = static_cast<float>(GetTime() - pulseStart);
+    float alpha       = pulsing ? 0.7f + 0.3f * cosf(elapsedTime * 2.0f) : 1.0f;
     Color textColor   = {255, 255, 255, static_cast<unsigned char>(alpha * 255)};
 
     const char* titleName = "Data Structure Visualizer";
-    DrawText(titleName, (GetScreenWidth() - MeasureText(titleName, titleFontSize)) / 2, GetScreenHeight() / 5, titleFontSize, WHITE);
+    queue.setLayer(RenderQueue::LAYER_TEXT);
+    queue.text(titleName, (GetScreenWidth() - MeasureText(titleName, titleFontSize)) / 2, GetScreenHeight() / 5, titleFontSize, WHITE);
 
     const char* guideText = "Press Enter to continue...";
-    DrawText(guideText, (GetScreenWidth() - MeasureText(guideText, baseFontSize)) / 3, GetScreenHeight() * 4 / 5, baseFontSize, textColor);
+    queue.text(guideText, (GetScreenWidth() - MeasureText(guideText, baseFontSize)) / 3, GetScreenHeight() * 4 / 5, baseFontSize, textColor);
+}
+
+bool Title::isAnimating() const
+{
+    return pulsing || !backgroundReady;
 }
 
 void Title::clean()
 {
-    UnloadTexture(background);
+    Application::getInstance()->getAssets().release(background);
+    background      = Texture2D{};
+    backgroundReady = false;
 }
 
 // =========================================================
@@ -385,8 +478,10 @@ void Menu::draw()
 {
     ClearBackground(RAYWHITE);
 
+    RenderQueue& queue    = Application::getInstance()->getRenderQueue();
     const char* titleName = "Data Structure Visualizer";
-    DrawText(titleName, (GetScreenWidth() - MeasureText(titleName, titleFontSize)) / 2, GetScreenHeight() / 5, titleFontSize, BLACK);
+    queue.setLayer(RenderQueue::LAYER_TEXT);
+    queue.text(titleName, (GetScreenWidth() - MeasureText(titleName, titleFontSize)) / 2, GetScreenHeight() / 5, titleFontSize, BLACK);
 
     // Draw all regular buttons
     for (auto& button : buttons) {
@@ -408,6 +503,12 @@ void Menu::clean()
 
 Application::Application()
 {
+    startTime = std::chrono::steady_clock::now();
+
+    // Decoding starts while the window opens, the title background first
+    assets.preload("images/a_ship_in_the_water.jpg", AssetManager::PRIORITY_HIGH);
+    assets.preload("images/img_holder.jpg");
+    assets.preload("images/left_arrow.png");
 
     SetTargetFPS(60);
     InitWindow(960, 540, "CS163");
@@ -417,7 +518,8 @@ Application::Application()
     SetWindowMaxSize(1920, 1080);
     SetWindowMinSize(960, 540);
 
-    instance = this; // To get instance of the Application from child
+    instance      = this; // To get instance of the Application from child
+    renderBackend = std::make_unique<RaylibBackend>();
 
     scenes.resize(6);
     scenes[static_cast<int>(Scene::TITLE)]      = std::make_unique<Title>();
@@ -436,21 +538,165 @@ Application::~Application()
 {
     if (currentScene)
         currentScene->clean();
+    if (frame.id != 0)
+        UnloadRenderTexture(frame);
+    assets.clear();
 
     CloseWindow();
 }
 
 void Application::update()
 {
+    assets.update();
+
+    float dt  = 1.0f / tickRate;
+    int ticks = 0;
+
+    // The first frame after waiting for events covers the whole wait. Ticks
+    // drop that backlog below, animations stepped per frame must not jump.
+    float frameTime = GetFrameTime();
+    accumulator += frameTime;
+    frameDelta = std::min(frameTime, MAX_FRAME_DELTA);
+    while (accumulator >= dt && ticks < maxCatchUp) {
+        simulate(1);
+        accumulator -= dt;
+        ticks++;
+    }
+
+    // After a long stall, drop the backlog instead of spiralling
+    if (accumulator >= dt) {
+        accumulator = fmodf(accumulator, dt);
+    }
+    alpha = accumulator / dt;
+
     if (currentScene) {
         currentScene->update();
     }
 }
 
+void Application::simulate(int ticks)
+{
+    float dt = 1.0f / tickRate;
+    for (int i = 0; i < ticks && currentScene; i++) {
+        currentScene->fixedUpdate(dt);
+    }
+}
+
+void Application::setTickRate(float ticksPerSecond)
+{
+    tickRate = std::max(1.0f, ticksPerSecond);
+}
+
+float Application::getTickRate() const
+{
+    return tickRate;
+}
+
+float Application::getTickDelta() const
+{
+    return 1.0f / tickRate;
+}
+
+void Application::setMaxCatchUp(int ticks)
+{
+    maxCatchUp = std::max(1, ticks);
+}
+
+float Application::getAlpha() const
+{
+    return alpha;
+}
+
+float Application::getFrameDelta() const
+{
+    return frameDelta;
+}
+
 void Application::draw()
 {
     if (currentScene)
         currentScene->draw();
+    renderQueue.flush(*renderBackend);
+}
+
+void Application::render()
+{
+    int width   = GetScreenWidth();
+    int height  = GetScreenHeight();
+    bool redraw = hasInput();
+    if (currentScene && currentScene->takeDirty())
+        redraw = true;
+
+    if (frame.id == 0 || frame.texture.width != width || frame.texture.height != height) {
+        if (frame.id != 0)
+            UnloadRenderTexture(frame);
+        frame  = LoadRenderTexture(width, height);
+        redraw = true;
+    }
+
+    if (redraw) {
+        BeginTextureMode(frame);
+        ClearBackground(RAYWHITE);
+        draw();
+        EndTextureMode();
+        if (redrawnFrames++ == 0) {
+            TraceLog(LOG_INFO, "STARTUP: first frame after %.1f ms",
+                     std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - startTime).count());
+        }
+    }
+    else {
+        renderQueue.clear(); // Recorded during update for a redraw that isn't happening
+    }
+
+    // Render textures are stored upside down
+    DrawTextureRec(frame.texture, Rectangle{0, 0, static_cast<float>(width), -static_cast<float>(height)}, Vector2{0, 0}, WHITE);
+
+    // Nothing moves on its own, so sleep in EndDrawing until the next input event
+    if (idle != !redraw) {
+        idle = !redraw;
+        if (idle)
+            EnableEventWaiting();
+        else
+            DisableEventWaiting();
+    }
+}
+
+bool Application::hasInput() const
+{
+    Vector2 mouseDelta = GetMouseDelta();
+    if (mouseDelta.x != 0 || mouseDelta.y != 0 || GetMouseWheelMove() != 0 || IsWindowResized())
+        return true;
+
+    for (int button = MOUSE_BUTTON_LEFT; button <= MOUSE_BUTTON_MIDDLE; button++) {
+        if (IsMouseButtonPressed(button) || IsMouseButtonReleased(button))
+            return true;
+    }
+    return false;
+}
+
+bool Application::isIdle() const
+{
+    return idle;
+}
+
+int Application::getRedrawnFrames() const
+{
+    return redrawnFrames;
+}
+
+AssetManager& Application::getAssets()
+{
+    return assets;
+}
+
+RenderQueue& Application::getRenderQueue()
+{
+    return renderQueue;
+}
+
+void Application::setRenderBackend(std::unique_ptr<RenderBackend> backend)
+{
+    renderBackend = std::move(backend);
 }
 
 Application* Application::getInstance()
@@ -468,18 +714,100 @@ void Application::changeScene(Scene newScene)
     if (!canChangeScene())
         return;
 
+    switchScene(newScene);
+}
+
+void Application::switchScene(Scene newScene)
+{
     int sceneIndex = static_cast<int>(newScene);
     if (sceneIndex >= 0 && sceneIndex < 6 && scenes[sceneIndex]) {
         if (currentScene)
             currentScene->clean();
         currentScene = scenes[sceneIndex].get();
         currentScene->init();
+        currentScene->markDirty();
 
         // Update last change scene
         lastSceneChangeTime = static_cast<float>(GetTime());
     }
 }
 
+bool Application::exportFrames(const ExportOptions& options)
+{
+    switchScene(options.scene);
+    currentScene->loadDemo();
+    setTickRate(options.fps);
+    if (options.count)
+        return countCommands(options);
+
+    int width              = GetScreenWidth();
+    int height             = GetScreenHeight();
+    RenderTexture2D target = LoadRenderTexture(width, height);
+    FrameExporter exporter(options.directory, options.format, options.workers);
+    double start           = GetTime();
+
+    for (int frame = 0; frame < options.frames; frame++) {
+        stepExportFrame();
+
+        BeginTextureMode(target);
+        ClearBackground(RAYWHITE);
+        draw();
+        EndTextureMode();
+
+        exporter.submit(LoadImageFromTexture(target.texture), frame);
+    }
+
+    int workers  = exporter.getWorkerCount();
+    bool written = exporter.finish();
+    UnloadRenderTexture(target);
+
+    double seconds = GetTime() - start;
+    TraceLog(LOG_INFO, "EXPORT: %d frames (%dx%d) to %s in %.2fs, %.1f fps, %d workers",
+             exporter.getWrittenCount(), width, height, options.directory.c_str(), seconds,
+             seconds > 0 ? options.frames / seconds : 0.0, workers);
+    return written;
+}
+
+void Application::stepExportFrame()
+{
+    // No BeginDrawing/EndDrawing here, so GetFrameTime() doesn't advance
+    simulate(1);
+    accumulator = 0.0f;
+    alpha       = 1.0f;
+    frameDelta  = getTickDelta();
+    currentScene->update();
+}
+
+bool Application::countCommands(const ExportOptions& options)
+{
+    static const char* const OP_NAMES[] = {"rectangle", "rectangle lines", "circle", "line", "triangle",
+                                           "text", "texture", "triangles", "lines", "glyphs"};
+    static_assert(std::size(OP_NAMES) == static_cast<size_t>(DrawOp::Glyphs) + 1, "One name per DrawOp");
+
+    // Scenes still drawing through raylib directly aren't counted
+    auto counter                           = std::make_unique<NullBackend>();
+    NullBackend& backend                   = *counter;
+    std::unique_ptr<RenderBackend> drawing = std::move(renderBackend);
+    renderBackend                          = std::move(counter);
+
+    for (int frame = 0; frame < options.frames; frame++) {
+        stepExportFrame();
+        draw();
+    }
+
+    double frames = backend.getFrames();
+    TraceLog(LOG_INFO, "COUNT: %d frames, per frame %.1f commands in %.1f batches, %.1f vertices",
+             backend.getFrames(), backend.getCommands() / frames, backend.getBatches() / frames, backend.getVertices() / frames);
+    for (int op = 0; op < static_cast<int>(std::size(OP_NAMES)); op++) {
+        long long commands = backend.getCommands(static_cast<DrawOp>(op));
+        if (commands > 0)
+            TraceLog(LOG_INFO, "COUNT:     %-16s %.1f per frame", OP_NAMES[op], commands / frames);
+    }
+
+    renderBackend = std::move(drawing);
+    return true;
+}
+
 bool Application::canChangeScene()
 {
     return (GetTime() - lastSceneChangeTime) >= sceneChangeCooldown;